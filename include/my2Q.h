@@ -0,0 +1,490 @@
+#ifndef MY2Q_H
+#define MY2Q_H
+
+#include <algorithm>
+#include <mutex>
+#include "myCachePolicy.h"
+#include "myLru.h"
+#include "myNodePool.h"
+#include "myHash.h"
+#include "myFlatHashMap.h"
+#include "myGhostList.h"
+#include "myTimingWheel.h"
+#include "myShardedCache.h"
+
+namespace myCacheSystem
+{
+    /*
+        2Q缓存(完整版，A1in/A1out/Am三个队列)
+        1. 新key进入A1in，A1in是FIFO，其中的结点命中时不移动
+        2. A1in超过 inRatio 对应的容量后，从队头移出的key只记入A1out(幽灵队列，不保存value)
+        3. 写入的新key命中A1out说明在有限的窗口内被第二次引用，直接进入Am；Am是LRU，命中移到最近使用端
+        4. 需要腾出空间时，A1in超过容量就淘汰A1in的队头(记入A1out)，否则淘汰Am最久未使用的结点(不记录)
+        一次性扫描只会流经A1in和A1out，不会冲掉Am；与 myKLruCache 不同，未准入的key不保存value
+        结点与 myLruCache 相同(myLruNode)，accessCount_ 为1表示在A1in，大于1表示在Am
+        所有操作在一把互斥锁内完成
+    */
+    template <typename KEY, typename VALUE>
+    class my2QCache : public myCachePolicy<KEY, VALUE>
+    {
+    public:
+        using LruNodeType = myLruNode<KEY, VALUE>;
+        using NodePtr = LruNodeType *;
+        using NodeMap = myFlatHashMap<KEY, NodePtr>;
+        using NodePool = myNodePool<LruNodeType>;
+        using GhostList = myGhostList<KEY>;
+        using Weigher = myWeigher<KEY, VALUE>;
+        using TimingWheel = myTimingWheel<LruNodeType>;
+
+        static constexpr size_t kExpireBudget = 16; // 每次写操作最多回收的过期结点数
+
+        /*
+            构造函数
+        */
+        // inRatio: A1in 占总容量的比例(Kin) outRatio: A1out 记录的key相对总容量的比例(Kout)，Am 使用剩余的空间
+        // weigher 非空时 capacity 为权重预算，三个队列都按权重计算，结点池按需扩容
+        explicit my2QCache(size_t capacity, double inRatio = 0.25, double outRatio = 0.5, Weigher weigher = Weigher())
+            : capacity_(capacity),
+              inCapacity_(static_cast<size_t>(capacity * std::clamp(inRatio, 0.0, 1.0))),
+              weigher_(std::move(weigher)),
+              pool_(weigher_ ? 4 : capacity + 4),
+              a1out_(static_cast<size_t>(capacity * std::max(outRatio, 0.0)))
+        {
+            segmentInit(a1in_);
+            segmentInit(am_);
+            if (!weigher_)
+            {
+                nodeMap_.reserve(capacity_);
+            }
+        }
+
+        ~my2QCache() override = default;
+
+        /*
+            成员函数接口
+        */
+        // 添加缓存
+        virtual void put(const KEY &key, const VALUE &value) override
+        {
+            putImpl(key, value);
+        }
+
+        virtual void put(KEY &&key, VALUE &&value) override
+        {
+            putImpl(std::move(key), std::move(value));
+        }
+
+        // 添加带过期时间的缓存
+        virtual void put(const KEY &key, const VALUE &value, std::chrono::milliseconds ttl) override
+        {
+            putImpl(key, value, myTimingWheelDeadline(ttl));
+        }
+
+        virtual void put(KEY &&key, VALUE &&value, std::chrono::milliseconds ttl) override
+        {
+            putImpl(std::move(key), std::move(value), myTimingWheelDeadline(ttl));
+        }
+
+        // 获取value
+        virtual bool get(const KEY &key, VALUE &value) override
+        {
+            return getImpl(key, value);
+        }
+
+        virtual VALUE get(const KEY &key) override
+        {
+            VALUE value{};
+            getImpl(key, value);
+            return value;
+        }
+
+        // 透明查找：std::string 键可以直接用 std::string_view 查询
+        template <typename K, typename = std::enable_if_t<myIsTransparentKey_v<KEY, K>>>
+        bool get(const K &key, VALUE &value)
+        {
+            return getImpl(key, value);
+        }
+
+        template <typename K, typename = std::enable_if_t<myIsTransparentKey_v<KEY, K>>>
+        VALUE get(const K &key)
+        {
+            VALUE value{};
+            getImpl(key, value);
+            return value;
+        }
+
+        // 非阻塞接口
+        virtual myTryStatus tryGet(const KEY &key, VALUE &value) override
+        {
+            std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+            if (!lock.owns_lock())
+            {
+                return myTryStatus::Busy;
+            }
+            expireEntries();
+            return getLocked(key, value) ? myTryStatus::Hit : myTryStatus::Miss;
+        }
+
+        virtual bool tryPut(const KEY &key, const VALUE &value) override
+        {
+            return putImpl<true>(key, value);
+        }
+
+        virtual bool tryPut(const KEY &key, const VALUE &value, std::chrono::milliseconds ttl) override
+        {
+            return putImpl<true>(key, value, myTimingWheelDeadline(ttl));
+        }
+
+        // 批量查询：整批只加一次锁
+        virtual size_t getMany(std::span<const KEY> keys, std::span<VALUE> values, std::vector<bool> &hits) override
+        {
+            hits.assign(keys.size(), false);
+            return getManyImpl(keys.size(), [](size_t i)
+                               { return i; }, keys, values, hits);
+        }
+
+        // 只查询 indexes 指定的位置，结果写入 values/hits 的相同位置(供分片缓存按分片分组后调用)
+        size_t getMany(std::span<const KEY> keys, std::span<const size_t> indexes, std::span<VALUE> values, std::vector<bool> &hits)
+        {
+            return getManyImpl(indexes.size(), [&](size_t i)
+                               { return indexes[i]; }, keys, values, hits);
+        }
+
+        // 批量添加：整批只加一次锁
+        virtual void putMany(std::span<const KEY> keys, std::span<const VALUE> values) override
+        {
+            putManyImpl(keys.size(), [](size_t i)
+                        { return i; }, keys, values);
+        }
+
+        void putMany(std::span<const KEY> keys, std::span<const size_t> indexes, std::span<const VALUE> values)
+        {
+            putManyImpl(indexes.size(), [&](size_t i)
+                        { return indexes[i]; }, keys, values);
+        }
+
+        // 删除指定结点
+        template <typename K>
+        void remove(const K &key)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = nodeMap_.find(key);
+            if (it != nodeMap_.end())
+            {
+                eraseNode(it->second);
+            }
+        }
+
+        // 清空缓存和A1out
+        void clear()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto &pair : nodeMap_)
+            {
+                pool_.deallocate(pair.second);
+            }
+            nodeMap_.clear();
+            for (Segment *segment : {&a1in_, &am_})
+            {
+                segment->head_->next_ = segment->tail_;
+                segment->tail_->prev_ = segment->head_;
+                segment->weight_ = 0;
+            }
+            a1out_.clear();
+            wheel_.clear();
+        }
+
+        // 缓存项数量
+        size_t size() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return nodeMap_.size();
+        }
+
+        // 当前缓存的总权重(A1in + Am，未设置权重函数时即缓存项数量)
+        size_t weight() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return a1in_.weight_ + am_.weight_;
+        }
+
+    private:
+        // 队列链表，头部为最早进入(A1in)或最久未使用(Am)
+        struct Segment
+        {
+            NodePtr head_ = nullptr; // 虚拟头结点
+            NodePtr tail_ = nullptr; // 虚拟尾结点
+            size_t weight_ = 0;      // 队列总权重
+        };
+
+        /*
+            私有成员函数方法
+        */
+        void segmentInit(Segment &segment)
+        {
+            segment.head_ = pool_.allocate();
+            segment.tail_ = pool_.allocate();
+            segment.head_->next_ = segment.tail_;
+            segment.tail_->prev_ = segment.head_;
+        }
+
+        Segment &segmentOf(NodePtr node)
+        {
+            return node->accessCount_ > 1 ? am_ : a1in_;
+        }
+
+        // 插入到队尾
+        void linkToRecent(Segment &segment, NodePtr node)
+        {
+            NodePtr prev = segment.tail_->prev_;
+            prev->next_ = node;
+            node->next_ = segment.tail_;
+            segment.tail_->prev_ = node;
+            node->prev_ = prev;
+            segment.weight_ += node->weight_;
+        }
+
+        void unlink(Segment &segment, NodePtr node)
+        {
+            node->prev_->next_ = node->next_;
+            node->next_->prev_ = node->prev_;
+            node->prev_ = nullptr;
+            node->next_ = nullptr;
+            segment.weight_ -= node->weight_;
+        }
+
+        // 队头结点，队列为空时返回nullptr
+        NodePtr eldest(Segment &segment) const
+        {
+            return segment.head_->next_ != segment.tail_ ? segment.head_->next_ : nullptr;
+        }
+
+        // TRY 为 true 时锁被占用直接返回false
+        template <bool TRY = false, typename K, typename V>
+        bool putImpl(K &&key, V &&value, uint64_t expireTick = 0)
+        {
+            if (capacity_ <= 0)
+                return true;
+
+            std::unique_lock<std::mutex> lock(mutex_, std::defer_lock);
+            if (!myAcquireLock<TRY>(lock))
+            {
+                return false;
+            }
+            expireEntries();
+            putLocked(std::forward<K>(key), std::forward<V>(value), expireTick);
+            return true;
+        }
+
+        template <typename K>
+        bool getImpl(const K &key, VALUE &value)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            expireEntries();
+            return getLocked(key, value);
+        }
+
+        // 批量查询，indexAt(i) 给出第i个要查询的下标
+        template <typename INDEX>
+        size_t getManyImpl(size_t count, INDEX &&indexAt, std::span<const KEY> keys, std::span<VALUE> values, std::vector<bool> &hits)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            expireEntries();
+            size_t hitCount = 0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                size_t index = indexAt(i);
+                if (getLocked(keys[index], values[index]))
+                {
+                    hits[index] = true;
+                    ++hitCount;
+                }
+            }
+            return hitCount;
+        }
+
+        // 批量添加
+        template <typename INDEX>
+        void putManyImpl(size_t count, INDEX &&indexAt, std::span<const KEY> keys, std::span<const VALUE> values)
+        {
+            if (capacity_ <= 0)
+                return;
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            expireEntries();
+            for (size_t i = 0; i < count; ++i)
+            {
+                size_t index = indexAt(i);
+                putLocked(keys[index], values[index]);
+            }
+        }
+
+        // 命中时拷贝value，Am中的结点移到最近使用端(调用者持有锁)
+        template <typename K>
+        bool getLocked(const K &key, VALUE &value)
+        {
+            auto it = nodeMap_.find(key);
+            if (it == nodeMap_.end() || isExpired(it->second))
+            {
+                return false;
+            }
+            value = it->second->value_;
+            onHit(it->second);
+            return true;
+        }
+
+        // 添加或更新缓存(调用者持有锁)
+        template <typename K, typename V>
+        void putLocked(K &&key, V &&value, uint64_t expireTick = 0)
+        {
+            auto it = nodeMap_.find(key);
+            if (it != nodeMap_.end())
+            {
+                // 已存在：更新值、权重和过期时间，按一次命中处理
+                NodePtr node = it->second;
+                node->value_ = std::forward<V>(value);
+                size_t weight = weigh(node->key_, node->value_);
+                if (weight > capacity_)
+                {
+                    eraseNode(node);
+                    return;
+                }
+                Segment &segment = segmentOf(node);
+                segment.weight_ = segment.weight_ - node->weight_ + weight;
+                node->weight_ = weight;
+                setExpiry(node, expireTick);
+                onHit(node);
+                while (a1in_.weight_ + am_.weight_ > capacity_)
+                {
+                    reclaim();
+                }
+                return;
+            }
+
+            // 超过整个容量的缓存项不缓存
+            size_t weight = weigh(key, value);
+            if (weight > capacity_)
+            {
+                return;
+            }
+
+            // 命中A1out的key第二次被引用，进入Am；否则进入A1in
+            size_t ghostWeight = 0;
+            bool admitted = a1out_.take(key, ghostWeight);
+            while (a1in_.weight_ + am_.weight_ + weight > capacity_)
+            {
+                reclaim();
+            }
+            NodePtr node = pool_.allocate();
+            node->key_ = key;
+            node->value_ = std::forward<V>(value);
+            node->accessCount_ = admitted ? 2 : 1;
+            node->weight_ = weight;
+            setExpiry(node, expireTick);
+            linkToRecent(admitted ? am_ : a1in_, node);
+            nodeMap_.emplace(std::forward<K>(key), node);
+        }
+
+        // 命中：A1in是FIFO，不移动；Am移到最近使用端
+        void onHit(NodePtr node)
+        {
+            if (node->accessCount_ > 1)
+            {
+                unlink(am_, node);
+                linkToRecent(am_, node);
+            }
+        }
+
+        // 腾出一个结点的空间：A1in超过容量(或Am为空)时淘汰A1in队头并记入A1out，否则淘汰Am最久未使用的结点
+        void reclaim()
+        {
+            NodePtr victim = eldest(am_);
+            if (a1in_.weight_ > inCapacity_ || !victim)
+            {
+                victim = eldest(a1in_);
+                a1out_.push(victim->key_, victim->weight_);
+            }
+            eraseNode(victim);
+        }
+
+        // 结点是否已经过期
+        bool isExpired(NodePtr node) const
+        {
+            return node->hasExpiry() && node->isExpired(myTimingWheelNow());
+        }
+
+        // 推进时间轮，回收最多 kExpireBudget 个过期结点(调用者持有锁)
+        void expireEntries()
+        {
+            if (wheel_.empty())
+            {
+                return;
+            }
+            wheel_.expire(myTimingWheelNow(), kExpireBudget, [this](NodePtr node)
+                          { eraseNode(node); });
+        }
+
+        // 设置结点的过期刻度，0表示不过期
+        void setExpiry(NodePtr node, uint64_t expireTick)
+        {
+            if (expireTick != 0)
+            {
+                wheel_.schedule(node, expireTick);
+            }
+            else
+            {
+                wheel_.cancel(node);
+            }
+        }
+
+        // 从队列、哈希表和时间轮中删除结点并归还结点池
+        void eraseNode(NodePtr node)
+        {
+            unlink(segmentOf(node), node);
+            nodeMap_.erase(node->key_);
+            wheel_.cancel(node);
+            pool_.deallocate(node);
+        }
+
+        // 计算缓存项权重
+        template <typename K, typename V>
+        size_t weigh(const K &key, const V &value) const
+        {
+            return weigher_ ? weigher_(key, value) : 1;
+        }
+
+        size_t capacity_;          // 总容量(权重单位)
+        size_t inCapacity_;        // A1in容量(Kin)
+        Weigher weigher_;          // 权重函数，为空时每个结点权重为1
+        mutable std::mutex mutex_; // 互斥锁
+        NodePool pool_;            // 结点池(含两个队列的虚拟头尾结点)
+        NodeMap nodeMap_;          // key——结点映射
+        TimingWheel wheel_;        // 时间轮，管理设置了过期时间的结点
+        Segment a1in_;             // A1in: FIFO
+        Segment am_;               // Am: LRU
+        GhostList a1out_;          // A1out: 只记录key的指纹(Kout)
+    };
+
+    /*
+        my2QCache 的分片版本
+        每个分片是一个独立加锁的 my2QCache，分片规则见 myShardedCache
+    */
+    template <typename KEY, typename VALUE>
+    class myHash2QCache : public myShardedCache<KEY, VALUE, my2QCache<KEY, VALUE>>
+    {
+        typedef myShardedCache<KEY, VALUE, my2QCache<KEY, VALUE>> Base;
+
+    public:
+        /*
+            构造函数
+        */
+        // weigher: 非空时 capacity 为总权重预算，按分片平均分配；A1in/A1out 按比例在每个分片内计算
+        myHash2QCache(size_t capacity, size_t sliceNum, double inRatio = 0.25, double outRatio = 0.5, myWeigher<KEY, VALUE> weigher = myWeigher<KEY, VALUE>())
+            : Base(capacity, sliceNum, [&](size_t sliceSize, size_t)
+                   { return std::make_unique<typename Base::Slice>(sliceSize, inRatio, outRatio, weigher); })
+        {
+        }
+    };
+} // namespace myCacheSystem
+
+#endif // MY2Q_H
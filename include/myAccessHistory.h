@@ -0,0 +1,161 @@
+#ifndef MYACCESSHISTORY_H
+#define MYACCESSHISTORY_H
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include "myHash.h"
+
+namespace myCacheSystem
+{
+    /*
+        访问历史表：固定内存记录最近访问过的key及其访问次数(LRU-K的历史队列)
+        1. 只保存key的32位指纹和8位饱和计数，每个槽8字节；8个槽组成一组，恰好一个缓存行
+        2. key的哈希选中一组，组内线性比较指纹；组满时用组内的CLOCK指针淘汰：
+           引用位为1的槽清零后跳过，第一个引用位为0的槽被替换
+        3. 表的大小在构造时确定，之后不再分配内存，扫描流量只会替换旧记录
+        不同key指纹相同时共享计数，只会让冷key提前达到k次，不影响正确性
+        访问历史本身不加锁，由所属缓存在锁内调用
+    */
+    template <typename KEY>
+    class myAccessHistory
+    {
+    public:
+        static constexpr size_t kWays = 8;          // 每组槽数
+        static constexpr uint32_t kMaxCount = 255;  // 计数上限
+
+        /*
+            构造函数
+        */
+        // capacity: 记录条数，取不小于 capacity 的 kWays * 2的幂
+        explicit myAccessHistory(size_t capacity)
+        {
+            size_t sets = std::bit_ceil(std::max<size_t>((capacity + kWays - 1) / kWays, 1));
+            slots_ = std::make_unique<Slot[]>(sets * kWays);
+            hands_ = std::make_unique<uint8_t[]>(sets);
+            setMask_ = sets - 1;
+        }
+
+        myAccessHistory(const myAccessHistory &) = delete;
+        myAccessHistory &operator=(const myAccessHistory &) = delete;
+
+        /*
+            成员函数接口
+        */
+        // 记录一次访问，返回累计访问次数；slot 返回记录所在的槽位，返回1表示新占用的槽位
+        template <typename K>
+        uint32_t touch(const K &key, size_t &slot)
+        {
+            uint64_t hash = hashOf(key);
+            uint32_t tag = tagOf(hash);
+            size_t base = (hash & setMask_) * kWays;
+            size_t empty = kWays;
+            for (size_t i = 0; i < kWays; ++i)
+            {
+                Slot &s = slots_[base + i];
+                if (s.tag_ == tag)
+                {
+                    s.count_ = static_cast<uint8_t>(std::min<uint32_t>(s.count_ + 1u, kMaxCount));
+                    s.referenced_ = 1;
+                    slot = base + i;
+                    return s.count_;
+                }
+                if (s.tag_ == 0 && empty == kWays)
+                {
+                    empty = i;
+                }
+            }
+            slot = base + (empty != kWays ? empty : evict(hash & setMask_));
+            slots_[slot] = Slot{tag, 1, 0, 0};
+            return 1;
+        }
+
+        // 访问次数，不在表中返回0
+        template <typename K>
+        uint32_t count(const K &key) const
+        {
+            size_t slot = 0;
+            return count(key, slot);
+        }
+
+        // 访问次数(不记录访问)，在表中时 slot 返回记录所在的槽位
+        template <typename K>
+        uint32_t count(const K &key, size_t &slot) const
+        {
+            uint64_t hash = hashOf(key);
+            uint32_t tag = tagOf(hash);
+            size_t base = (hash & setMask_) * kWays;
+            for (size_t i = 0; i < kWays; ++i)
+            {
+                if (slots_[base + i].tag_ == tag)
+                {
+                    slot = base + i;
+                    return slots_[base + i].count_;
+                }
+            }
+            return 0;
+        }
+
+        // 删除槽位上的记录
+        void erase(size_t slot)
+        {
+            slots_[slot] = Slot{};
+        }
+
+        void clear()
+        {
+            std::fill_n(slots_.get(), slots(), Slot{});
+            std::fill_n(hands_.get(), setMask_ + 1, uint8_t(0));
+        }
+
+        // 槽位总数(最多记录的key数)
+        size_t slots() const { return (setMask_ + 1) * kWays; }
+
+        // 占用的内存(字节)，构造后不变
+        size_t memoryBytes() const { return slots() * sizeof(Slot) + (setMask_ + 1); }
+
+    private:
+        struct Slot
+        {
+            uint32_t tag_ = 0;        // key的指纹，0表示空槽
+            uint8_t count_ = 0;       // 饱和访问计数
+            uint8_t referenced_ = 0;  // CLOCK引用位，再次访问时置1
+            uint16_t reserved_ = 0;
+        };
+
+        template <typename K>
+        static uint64_t hashOf(const K &key)
+        {
+            myKeyHash<KEY> hashFunc;
+            return myHashMix(hashFunc(key));
+        }
+
+        // 高32位作为指纹，最低位置1保证非0
+        static uint32_t tagOf(uint64_t hash)
+        {
+            return static_cast<uint32_t>(hash >> 32) | 1u;
+        }
+
+        // 组内CLOCK淘汰，返回被替换的槽在组内的下标
+        size_t evict(size_t set)
+        {
+            Slot *slots = &slots_[set * kWays];
+            uint8_t &hand = hands_[set];
+            while (slots[hand].referenced_)
+            {
+                slots[hand].referenced_ = 0;
+                hand = (hand + 1) & (kWays - 1);
+            }
+            size_t victim = hand;
+            hand = (hand + 1) & (kWays - 1);
+            return victim;
+        }
+
+        std::unique_ptr<Slot[]> slots_;     // 槽位数组，每组 kWays 个
+        std::unique_ptr<uint8_t[]> hands_;  // 每组的CLOCK指针
+        size_t setMask_;                    // 组数 - 1
+    };
+} // namespace myCacheSystem
+
+#endif // MYACCESSHISTORY_H
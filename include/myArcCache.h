@@ -2,22 +2,63 @@
 #define MYARCCACHED_H
 
 #include <memory>
+#include <mutex>
+#include <algorithm>
 #include "myCachePolicy.h"
-#include "myArcLruCachePart.h"
-#include "myArcLfuCachePart.h"
+#include "myArcCacheNode.h"
+#include "myNodePool.h"
+#include "myHash.h"
+#include "myFlatHashMap.h"
+#include "myGhostList.h"
+#include "myTimingWheel.h"
+#include "myShardedCache.h"
+#include "myValueHandle.h"
+#include "myRefreshAhead.h"
 
 namespace myCacheSystem
 {
+    /*
+        ARC(Adaptive Replacement Cache)
+        1. T1: 最近只访问过一次的结点；T2: 访问次数达到 transformThreshold(默认2，即经典ARC)的结点，两者都按LRU排列
+        2. B1/B2: 从T1/T2淘汰的key，幽灵链表只记录指纹和权重
+        3. 目标大小p是T1的期望权重：写入的新key命中B1说明T1偏小，p增大；命中B2说明T2偏小，p减小，
+           增量为命中记录的权重乘以两个幽灵链表的权重比(至少1)，命中幽灵链表的key直接进入T2
+        4. 需要腾出空间时，T1超过p(或者命中B2且T1恰好等于p)就把T1的LRU端淘汰到B1，否则把T2的LRU端淘汰到B2
+        5. 与经典ARC相同地限制目录大小：|T1| + |B1| 不超过 c，四个链表合计不超过 c + ghostCapacity(默认 2c)，
+           超出时分别丢弃B1、B2最早的记录；ghostCapacity 只放宽B2和总量，B1始终受 c - |T1| 约束
+        读未命中不会回填value，幽灵链表只在写入新key时检查(读未命中之后通常紧跟着回源写入)
+        transformThreshold 大于2时T1结点要多次命中才进入T2，不再是经典ARC
+        所有状态由一把互斥锁保护，每个操作只加一次锁；过期的结点直接删除，不进入幽灵链表
+    */
     template <typename KEY, typename VALUE>
     class myArcCache : public myCachePolicy<KEY, VALUE>
     {
     public:
+        typedef myArcCacheNode<KEY, VALUE> NODE;
+        typedef NODE *NODEPTR;
+        typedef myFlatHashMap<KEY, NODEPTR> NODEMAP;
+        typedef myNodePool<NODE> NODEPOOL;
+        typedef myGhostList<KEY> GHOSTLIST;
+        typedef myWeigher<KEY, VALUE> WEIGHER;
+        typedef myTimingWheel<NODE> TIMINGWHEEL;
+        typedef myPinnedNodes<NODE> PINNEDNODES;
+        typedef myRefreshAhead<KEY, VALUE> REFRESHAHEAD;
+
+        static constexpr size_t kExpireBudget = 16; // 每次写操作最多回收的过期结点数
+
         /*
             构造函数
         */
-        explicit myArcCache(size_t capacity = 10, size_t transformThreshold = 2)
-            : capacity_(capacity), transformThreshold_(transformThreshold), lruPart_(std::make_unique<myArcLruCachePart<KEY, VALUE>>(capacity, transformThreshold)), lfuPart_(std::make_unique<myArcLfuCachePart<KEY, VALUE>>(capacity, transformThreshold))
+        // weigher 非空时 capacity 为权重预算，p 和幽灵链表也以权重为单位，结点池按需扩容
+        // ghostCapacity: B2 的容量和四个链表合计超出 capacity 的部分(权重单位)，0表示与 capacity 相同；B1 另受 |T1| + |B1| <= capacity 约束
+        explicit myArcCache(size_t capacity = 10, size_t transformThreshold = 2, WEIGHER weigher = WEIGHER(), size_t ghostCapacity = 0)
+            : capacity_(capacity), transformThreshold_(std::max<size_t>(transformThreshold, 2)), p_(0), t1Weight_(0), t2Weight_(0), weigher_(std::move(weigher)), pool_(weigher_ ? 4 : capacity + 4), b1_(capacity), b2_(ghostCapacity > 0 ? ghostCapacity : capacity)
         {
+            if (!weigher_)
+            {
+                nodeMap_.reserve(capacity_);
+            }
+            initArcCacheList();
         }
 
         ~myArcCache() override = default;
@@ -26,77 +67,622 @@ namespace myCacheSystem
             成员函数
         */
         // 添加缓存
-        virtual void put(KEY key, VALUE value) override
+        virtual void put(const KEY &key, const VALUE &value) override
+        {
+            putImpl(key, value);
+        }
+
+        virtual void put(KEY &&key, VALUE &&value) override
+        {
+            putImpl(std::move(key), std::move(value));
+        }
+
+        // 添加带过期时间的缓存
+        virtual void put(const KEY &key, const VALUE &value, std::chrono::milliseconds ttl) override
+        {
+            putImpl(key, value, myTimingWheelDeadline(ttl));
+        }
+
+        virtual void put(KEY &&key, VALUE &&value, std::chrono::milliseconds ttl) override
+        {
+            putImpl(std::move(key), std::move(value), myTimingWheelDeadline(ttl));
+        }
+
+        // 获取value
+        virtual bool get(const KEY &key, VALUE &value) override
+        {
+            return getImpl(key, value);
+        }
+
+        // 访问缓存数据函数
+        virtual VALUE get(const KEY &key) override
+        {
+            VALUE value{};
+            getImpl(key, value);
+            return value;
+        }
+
+        // 透明查找：std::string 键可以直接用 std::string_view 查询
+        template <typename K, typename = std::enable_if_t<myIsTransparentKey_v<KEY, K>>>
+        bool get(const K &key, VALUE &value)
+        {
+            return getImpl(key, value);
+        }
+
+        template <typename K, typename = std::enable_if_t<myIsTransparentKey_v<KEY, K>>>
+        VALUE get(const K &key)
         {
-            checkGhostCaches(key);
+            VALUE value{};
+            getImpl(key, value);
+            return value;
+        }
 
-            // 检查LFU缓存是否存在key
-            bool inLfu = lfuPart_->contain(key);
-            // 更新LRU部分缓存
-            lruPart_->put(key, value);
-            if (inLfu)
+        // 非阻塞接口
+        virtual myTryStatus tryGet(const KEY &key, VALUE &value) override
+        {
+            std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+            if (!lock.owns_lock())
             {
-                lfuPart_->put(key, value);
+                return myTryStatus::Busy;
             }
+            expireEntries();
+            return getLocked(key, value) ? myTryStatus::Hit : myTryStatus::Miss;
         }
 
-        // 获取value
-        virtual bool get(KEY key, VALUE &value) override
+        virtual bool tryPut(const KEY &key, const VALUE &value) override
+        {
+            return putImpl<true>(key, value);
+        }
+
+        virtual bool tryPut(const KEY &key, const VALUE &value, std::chrono::milliseconds ttl) override
+        {
+            return putImpl<true>(key, value, myTimingWheelDeadline(ttl));
+        }
+
+        // 零拷贝读取：返回指向缓存中value的句柄，命中的处理与 get 相同，见 myValueHandle
+        template <typename K>
+        myValueHandle<VALUE> getHandle(const K &key)
+        {
+            auto guard = pinnedNodes_.pin();
+            const VALUE *value = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                expireEntries();
+                visitLocked(key, [&](NODEPTR node)
+                            {
+                    node->pinned_ = true;
+                    value = &node->value_; });
+            }
+            return value ? myValueHandle<VALUE>(std::move(guard), value) : myValueHandle<VALUE>();
+        }
+
+        // 批量查询：整批只加一次锁
+        virtual size_t getMany(std::span<const KEY> keys, std::span<VALUE> values, std::vector<bool> &hits) override
+        {
+            hits.assign(keys.size(), false);
+            return getManyImpl(keys.size(), [](size_t i)
+                               { return i; }, keys, values, hits);
+        }
+
+        // 只查询 indexes 指定的位置，结果写入 values/hits 的相同位置(供分片缓存按分片分组后调用)
+        size_t getMany(std::span<const KEY> keys, std::span<const size_t> indexes, std::span<VALUE> values, std::vector<bool> &hits)
+        {
+            return getManyImpl(indexes.size(), [&](size_t i)
+                               { return indexes[i]; }, keys, values, hits);
+        }
+
+        // 批量添加：整批只加一次锁
+        virtual void putMany(std::span<const KEY> keys, std::span<const VALUE> values) override
+        {
+            putManyImpl(keys.size(), [](size_t i)
+                        { return i; }, keys, values);
+        }
+
+        void putMany(std::span<const KEY> keys, std::span<const size_t> indexes, std::span<const VALUE> values)
+        {
+            putManyImpl(indexes.size(), [&](size_t i)
+                        { return indexes[i]; }, keys, values);
+        }
+
+        // 清空缓存和幽灵链表，目标大小归零
+        void clear()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto &pair : nodeMap_)
+            {
+                releaseNode(pair.second);
+            }
+            nodeMap_.clear();
+            headT1_->next_ = tailT1_;
+            tailT1_->prev_ = headT1_;
+            headT2_->next_ = tailT2_;
+            tailT2_->prev_ = headT2_;
+            b1_.clear();
+            b2_.clear();
+            wheel_.clear();
+            p_ = 0;
+            t1Weight_ = 0;
+            t2Weight_ = 0;
+        }
+
+        // 当前缓存的总权重(T1 + T2)
+        size_t weight() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return t1Weight_ + t2Weight_;
+        }
+
+        // T1 的目标权重
+        size_t target() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return p_;
+        }
+
+        // 开启写入后刷新：写入 refreshAfter 之后的命中返回旧值，并在 executor 上用 loader 重新加载一次，见 myRefreshAhead
+        void enableRefresh(std::chrono::milliseconds refreshAfter, typename REFRESHAHEAD::Loader loader, myExecutor &executor = myExecutor::defaultExecutor(),
+                           std::shared_ptr<myRefreshBudget> budget = nullptr)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            refresh_.enable(refreshAfter, std::move(loader), [this](const KEY &key, VALUE &&value, uint64_t expireTick)
+                            { refreshIfPending(key, std::move(value), expireTick); }, executor, std::move(budget));
+        }
+
+    private:
+        /*
+            私有成员函数方法
+        */
+        // 初始化T1、T2链表
+        void initArcCacheList();
+
+        // expireTick: 过期刻度，0表示不过期；TRY 为 true 时锁被占用直接返回false
+        template <bool TRY = false, typename K, typename V>
+        bool putImpl(K &&key, V &&value, uint64_t expireTick = 0)
+        {
+            if (capacity_ == 0)
+                return true;
+
+            std::unique_lock<std::mutex> lock(mutex_, std::defer_lock);
+            if (!myAcquireLock<TRY>(lock))
+            {
+                return false;
+            }
+            expireEntries();
+            putLocked(std::forward<K>(key), std::forward<V>(value), expireTick);
+            return true;
+        }
+
+        template <typename K>
+        bool getImpl(const K &key, VALUE &value)
         {
-            checkGhostCaches(key);
+            std::lock_guard<std::mutex> lock(mutex_);
+            expireEntries();
+            return getLocked(key, value);
+        }
 
-            bool shouldTransform = false;
-            if (lruPart_->get(key, value, shouldTransform))
+        // 批量查询，indexAt(i) 给出第i个要查询的下标
+        template <typename INDEX>
+        size_t getManyImpl(size_t count, INDEX &&indexAt, std::span<const KEY> keys, std::span<VALUE> values, std::vector<bool> &hits)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            expireEntries();
+            size_t hitCount = 0;
+            for (size_t i = 0; i < count; ++i)
             {
-                if (shouldTransform)
+                size_t index = indexAt(i);
+                if (getLocked(keys[index], values[index]))
                 {
-                    lfuPart_->put(key, value);
+                    hits[index] = true;
+                    ++hitCount;
                 }
-                return true;
             }
+            return hitCount;
+        }
+
+        // 批量添加
+        template <typename INDEX>
+        void putManyImpl(size_t count, INDEX &&indexAt, std::span<const KEY> keys, std::span<const VALUE> values)
+        {
+            if (capacity_ == 0)
+                return;
 
-            return lfuPart_->get(key, value);
+            std::lock_guard<std::mutex> lock(mutex_);
+            expireEntries();
+            for (size_t i = 0; i < count; ++i)
+            {
+                size_t index = indexAt(i);
+                putLocked(keys[index], values[index]);
+            }
         }
 
-        // 访问缓存数据函数
-        virtual VALUE get(KEY key) override
+        // 命中时拷贝value并更新位置(调用者持有锁)
+        template <typename K>
+        bool getLocked(const K &key, VALUE &value)
         {
-            VALUE value{};
-            get(key, value);
-            return value;
+            return visitLocked(key, [&](NODEPTR node)
+                               { value = node->value_; });
         }
 
-    private:
-        bool checkGhostCaches(KEY key);
+        // 命中时调用 visit(node) 并更新位置(调用者持有锁)
+        template <typename K, typename VISIT>
+        bool visitLocked(const K &key, VISIT &&visit)
+        {
+            auto it = nodeMap_.find(key);
+            if (it == nodeMap_.end() || isExpired(it->second))
+            {
+                return false;
+            }
+            refresh_.onHit(it->second);
+            visit(it->second);
+            onHit(it->second);
+            return true;
+        }
+
+        // 添加或更新缓存(调用者持有锁)
+        template <typename K, typename V>
+        void putLocked(K &&key, V &&value, uint64_t expireTick = 0);
+
+        // 命中：访问次数达到阈值的T1结点移到T2，其余移到所在链表的MRU端
+        void onHit(NODEPTR node);
+
+        // 腾出一个结点的空间，inB2 表示正在写入的key命中了B2
+        void replace(bool inB2);
+
+        // 淘汰链表LRU端的结点，key和权重记入对应的幽灵链表
+        void evictFrom(myArcList list);
+
+        // 按经典ARC的目录约束裁剪幽灵链表：|T1| + |B1| <= c，|T1| + |T2| + |B1| + |B2| <= c + B2容量
+        void trimGhosts();
+
+        // 从链表、哈希表和时间轮中删除结点(不进入幽灵链表)
+        void eraseNode(NODEPTR node);
+
+        // 释放value并归还结点池；交出过句柄的结点等待所有句柄释放后再归还
+        void releaseNode(NODEPTR node);
+
+        // 从结点池取出结点，先回收已经没有句柄引用的结点
+        NODEPTR allocateNode();
+
+        // 用新结点顶替交出过句柄的结点(链表位置、哈希表、过期时间和访问次数不变)，旧结点等待延迟回收
+        NODEPTR replacePinnedNode(NODEPTR old);
+
+        // 插入到链表的MRU端
+        void linkToRecent(NODEPTR node, myArcList list);
+
+        // 从所在链表摘下
+        void unlink(NODEPTR node);
+
+        // 结点是否已经过期
+        bool isExpired(NODEPTR node) const
+        {
+            return node->hasExpiry() && node->isExpired(myTimingWheelNow());
+        }
 
-        size_t capacity_;                                        // 总容量
-        size_t transformThreshold_;                              // 转移阈值
-        std::unique_ptr<myArcLruCachePart<KEY, VALUE>> lruPart_; // lru缓存池
-        std::unique_ptr<myArcLfuCachePart<KEY, VALUE>> lfuPart_; // lfu缓存池
+        // 回收最多 kExpireBudget 个过期结点
+        void expireEntries();
+
+        // 设置结点的过期刻度(0表示不过期)，开启刷新时同时记录刷新刻度
+        void setExpiry(NODEPTR node, uint64_t expireTick);
+
+        // 写回后台刷新的结果：结点仍处于已认领状态(刷新期间没有被重新写入、移出或过期)时才更新
+        void refreshIfPending(const KEY &key, VALUE &&value, uint64_t expireTick);
+
+        // 计算缓存项权重
+        template <typename K, typename V>
+        size_t weigh(const K &key, const V &value) const
+        {
+            return weigher_ ? weigher_(key, value) : 1;
+        }
+
+        size_t capacity_;           // 总容量(权重单位)
+        size_t transformThreshold_; // 进入T2需要的访问次数
+        size_t p_;                  // T1的目标权重
+        size_t t1Weight_;           // T1当前总权重
+        size_t t2Weight_;           // T2当前总权重
+        WEIGHER weigher_;           // 权重函数，为空时每个结点权重为1
+        NODEPOOL pool_;             // 结点池(含4个虚拟结点)
+        NODEPTR headT1_;            // T1虚拟头节点(LRU端)
+        NODEPTR tailT1_;            // T1虚拟尾节点(MRU端)
+        NODEPTR headT2_;            // T2虚拟头节点(LRU端)
+        NODEPTR tailT2_;            // T2虚拟尾节点(MRU端)
+        NODEMAP nodeMap_;           // key-node
+        GHOSTLIST b1_;              // T1的幽灵链表
+        GHOSTLIST b2_;              // T2的幽灵链表
+        TIMINGWHEEL wheel_;         // 时间轮，管理设置了过期时间的结点
+        mutable std::mutex mutex_;  // 互斥锁
+        PINNEDNODES pinnedNodes_;   // 交出过句柄、等待延迟回收的结点
+        REFRESHAHEAD refresh_;      // 写入后刷新，最先析构，等待进行中的刷新结束
     };
 
     template <typename KEY, typename VALUE>
-    bool myArcCache<KEY, VALUE>::checkGhostCaches(KEY key)
+    void myArcCache<KEY, VALUE>::initArcCacheList()
+    {
+        headT1_ = pool_.allocate();
+        tailT1_ = pool_.allocate();
+        headT1_->next_ = tailT1_;
+        tailT1_->prev_ = headT1_;
+
+        headT2_ = pool_.allocate();
+        tailT2_ = pool_.allocate();
+        headT2_->next_ = tailT2_;
+        tailT2_->prev_ = headT2_;
+    }
+
+    template <typename KEY, typename VALUE>
+    template <typename K, typename V>
+    void myArcCache<KEY, VALUE>::putLocked(K &&key, V &&value, uint64_t expireTick)
     {
-        bool isInGhost = false;
-        if (lruPart_->checkGhost(key))
+        // 1. 已在缓存中：更新值、权重和过期时间，按一次命中处理
+        auto it = nodeMap_.find(key);
+        if (it != nodeMap_.end())
         {
-            if (lfuPart_->decreaseCapacity())
+            NODEPTR node = it->second;
+            // 交出过句柄的结点不能原地修改，先换成新结点
+            if (node->pinned_)
             {
-                lruPart_->increaseCapacity();
+                node = replacePinnedNode(node);
             }
-            isInGhost = true;
-        }
-        else if (lfuPart_->checkGhost(key))
-        {
-            if (lruPart_->decreaseCapacity())
+            node->value_ = std::forward<V>(value);
+            size_t weight = weigh(node->key_, node->value_);
+            if (weight > capacity_)
+            {
+                eraseNode(node);
+                return;
+            }
+            (node->list_ == myArcList::T1 ? t1Weight_ : t2Weight_) += weight;
+            (node->list_ == myArcList::T1 ? t1Weight_ : t2Weight_) -= node->weight_;
+            node->weight_ = weight;
+            setExpiry(node, expireTick);
+            onHit(node);
+            // 权重变大后可能超出容量
+            while (t1Weight_ + t2Weight_ > capacity_)
             {
-                lfuPart_->increaseCapacity();
+                replace(false);
             }
-            isInGhost = true;
+            trimGhosts();
+            return;
+        }
+
+        // 2. 超过整个容量的缓存项不缓存
+        size_t weight = weigh(key, value);
+        if (weight > capacity_)
+        {
+            return;
+        }
+
+        // 3. 检查幽灵链表，调整目标大小
+        myArcList list = myArcList::T1;
+        bool inB2 = false;
+        size_t b1Weight = b1_.weight();
+        size_t b2Weight = b2_.weight();
+        size_t ghostWeight = 0;
+        if (b1_.take(key, ghostWeight))
+        {
+            // 命中B1：T1偏小
+            size_t delta = std::max<size_t>(b2Weight / std::max<size_t>(b1Weight, 1), 1) * ghostWeight;
+            p_ = std::min(capacity_, p_ + delta);
+            list = myArcList::T2;
+        }
+        else if (b2_.take(key, ghostWeight))
+        {
+            // 命中B2：T2偏小
+            size_t delta = std::max<size_t>(b1Weight / std::max<size_t>(b2Weight, 1), 1) * ghostWeight;
+            p_ -= std::min(p_, delta);
+            list = myArcList::T2;
+            inB2 = true;
+        }
+
+        // 4. 腾出空间后插入
+        while (t1Weight_ + t2Weight_ + weight > capacity_)
+        {
+            replace(inB2);
+        }
+        NODEPTR node = allocateNode();
+        node->key_ = key;
+        node->value_ = std::forward<V>(value);
+        node->accessCount_ = list == myArcList::T2 ? transformThreshold_ : 1;
+        node->weight_ = weight;
+        setExpiry(node, expireTick);
+        linkToRecent(node, list);
+        nodeMap_.emplace(std::forward<K>(key), node);
+        // T1 淘汰到 B1 不改变 |T1| + |B1|，新结点进入T1后超出的部分从B1最早的记录丢弃
+        trimGhosts();
+    }
+
+    template <typename KEY, typename VALUE>
+    void myArcCache<KEY, VALUE>::onHit(NODEPTR node)
+    {
+        node->addAccessCount();
+        myArcList list = node->list_;
+        if (list == myArcList::T1 && node->accessCount_ >= transformThreshold_)
+        {
+            list = myArcList::T2;
+        }
+        unlink(node);
+        linkToRecent(node, list);
+    }
+
+    template <typename KEY, typename VALUE>
+    void myArcCache<KEY, VALUE>::replace(bool inB2)
+    {
+        // T1超过目标大小时淘汰T1，否则淘汰T2；被选中的链表为空时淘汰另一个
+        bool fromT1 = t1Weight_ > 0 && (t1Weight_ > p_ || (inB2 && t1Weight_ == p_));
+        if (!fromT1 && t2Weight_ == 0)
+        {
+            fromT1 = true;
+        }
+        evictFrom(fromT1 ? myArcList::T1 : myArcList::T2);
+    }
+
+    template <typename KEY, typename VALUE>
+    void myArcCache<KEY, VALUE>::evictFrom(myArcList list)
+    {
+        NODEPTR head = list == myArcList::T1 ? headT1_ : headT2_;
+        NODEPTR tail = list == myArcList::T1 ? tailT1_ : tailT2_;
+        NODEPTR node = head->next_;
+        if (node == tail)
+            return;
+
+        unlink(node);
+        nodeMap_.erase(node->key_);
+        wheel_.cancel(node);
+        // 幽灵链表只记录key和权重，value立即释放(有句柄引用时延迟释放)，结点归还给结点池
+        (list == myArcList::T1 ? b1_ : b2_).push(node->key_, node->weight_);
+        releaseNode(node);
+    }
+
+    template <typename KEY, typename VALUE>
+    void myArcCache<KEY, VALUE>::trimGhosts()
+    {
+        while (t1Weight_ + b1_.weight() > capacity_ && b1_.size() != 0)
+        {
+            b1_.popFront();
+        }
+        while (t1Weight_ + t2Weight_ + b1_.weight() + b2_.weight() > capacity_ + b2_.capacity() && b2_.size() != 0)
+        {
+            b2_.popFront();
+        }
+    }
+
+    template <typename KEY, typename VALUE>
+    void myArcCache<KEY, VALUE>::eraseNode(NODEPTR node)
+    {
+        unlink(node);
+        nodeMap_.erase(node->key_);
+        wheel_.cancel(node);
+        releaseNode(node);
+    }
+
+    template <typename KEY, typename VALUE>
+    void myArcCache<KEY, VALUE>::releaseNode(NODEPTR node)
+    {
+        if (node->pinned_)
+        {
+            pinnedNodes_.retire(node);
+            return;
+        }
+        pool_.deallocate(node);
+    }
+
+    template <typename KEY, typename VALUE>
+    typename myArcCache<KEY, VALUE>::NODEPTR myArcCache<KEY, VALUE>::allocateNode()
+    {
+        pinnedNodes_.reclaim([this](NODEPTR node)
+                             {
+            node->pinned_ = false;
+            pool_.deallocate(node); });
+        return pool_.allocate();
+    }
+
+    template <typename KEY, typename VALUE>
+    typename myArcCache<KEY, VALUE>::NODEPTR myArcCache<KEY, VALUE>::replacePinnedNode(NODEPTR old)
+    {
+        NODEPTR node = allocateNode();
+        node->key_ = old->key_;
+        node->accessCount_ = old->accessCount_;
+        node->weight_ = old->weight_;
+        node->list_ = old->list_;
+        node->prev_ = old->prev_;
+        node->next_ = old->next_;
+        node->prev_->next_ = node;
+        node->next_->prev_ = node;
+        old->prev_ = nullptr;
+        old->next_ = nullptr;
+        nodeMap_.find(node->key_)->second = node;
+        if (old->hasExpiry())
+        {
+            wheel_.schedule(node, old->getExpireTick());
+        }
+        wheel_.cancel(old);
+        pinnedNodes_.retire(old);
+        return node;
+    }
+
+    template <typename KEY, typename VALUE>
+    void myArcCache<KEY, VALUE>::linkToRecent(NODEPTR node, myArcList list)
+    {
+        NODEPTR tail = list == myArcList::T1 ? tailT1_ : tailT2_;
+        NODEPTR prev = tail->prev_;
+        prev->next_ = node;
+        node->next_ = tail;
+        tail->prev_ = node;
+        node->prev_ = prev;
+        node->list_ = list;
+        (list == myArcList::T1 ? t1Weight_ : t2Weight_) += node->weight_;
+    }
+
+    template <typename KEY, typename VALUE>
+    void myArcCache<KEY, VALUE>::unlink(NODEPTR node)
+    {
+        if (node->prev_ && node->next_)
+        {
+            node->prev_->next_ = node->next_;
+            node->next_->prev_ = node->prev_;
+            node->prev_ = nullptr;
+            node->next_ = nullptr;
+            (node->list_ == myArcList::T1 ? t1Weight_ : t2Weight_) -= node->weight_;
+        }
+    }
+
+    template <typename KEY, typename VALUE>
+    void myArcCache<KEY, VALUE>::expireEntries()
+    {
+        if (wheel_.empty())
+        {
+            return;
+        }
+        // 过期不代表被挤出，不进入幽灵链表
+        wheel_.expire(myTimingWheelNow(), kExpireBudget, [this](NODEPTR node)
+                      { eraseNode(node); });
+    }
+
+    template <typename KEY, typename VALUE>
+    void myArcCache<KEY, VALUE>::setExpiry(NODEPTR node, uint64_t expireTick)
+    {
+        node->setRefreshTick(refresh_.deadline());
+        if (expireTick != 0)
+        {
+            wheel_.schedule(node, expireTick);
+        }
+        else
+        {
+            wheel_.cancel(node);
+        }
+    }
+
+    template <typename KEY, typename VALUE>
+    void myArcCache<KEY, VALUE>::refreshIfPending(const KEY &key, VALUE &&value, uint64_t expireTick)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        expireEntries();
+        auto it = nodeMap_.find(key);
+        if (it == nodeMap_.end() || isExpired(it->second) || it->second->getRefreshTick() != 0)
+        {
+            return;
         }
-        return isInGhost;
+        putLocked(key, std::move(value), expireTick);
     }
+
+    /*
+        myHashArcCache
+        每个分片是一个独立加锁的 myArcCache，各分片独立自适应，分片规则见 myShardedCache
+    */
+    template <typename KEY, typename VALUE>
+    class myHashArcCache : public myShardedCache<KEY, VALUE, myArcCache<KEY, VALUE>>
+    {
+        typedef myShardedCache<KEY, VALUE, myArcCache<KEY, VALUE>> Base;
+
+    public:
+        /*
+            构造函数
+        */
+        // weigher 非空时 capacity 为总权重预算；capacity 和 ghostCapacity(B2容量，见 myArcCache)都按分片平均分配
+        myHashArcCache(size_t capacity, size_t sliceNum, size_t transformThreshold = 2, myWeigher<KEY, VALUE> weigher = myWeigher<KEY, VALUE>(), size_t ghostCapacity = 0)
+            : Base(capacity, sliceNum, [&](size_t sliceSize, size_t sliceNumber)
+                   { return std::make_unique<typename Base::Slice>(sliceSize, transformThreshold, weigher, (ghostCapacity + sliceNumber - 1) / sliceNumber); })
+        {
+        }
+    };
 }
 
-#endif // MYARCCACHED_H
\ No newline at end of file
+#endif // MYARCCACHED_H
@@ -2,35 +2,39 @@
 #define MYARCCACHENODE_H
 
 #include <memory>
+#include "myTimingWheel.h"
 
 namespace myCacheSystem
 {
     // 前向声明
     template <typename KEY, typename VALUE>
-    class myArcLruCachePart;
+    class myArcCache;
 
-    template <typename KEY, typename VALUE>
-    class myArcLfuCachePart;
+    // 结点所在的ARC链表
+    enum class myArcList : uint8_t
+    {
+        T1, // 最近只访问过一次
+        T2  // 最近访问过多次
+    };
 
     /*
-        节点
+        节点，继承时间轮钩子以支持过期时间
     */
     template <typename KEY, typename VALUE>
-    class myArcCacheNode
+    class myArcCacheNode : public myTimerNode
     {
-        friend myArcLruCachePart<KEY, VALUE>;
-        friend myArcLfuCachePart<KEY, VALUE>;
+        friend class myArcCache<KEY, VALUE>;
 
     public:
         /*
             构造函数
         */
         // 默认构造
-        myArcCacheNode() : accessCount_(1), next_(nullptr) {}
+        myArcCacheNode() : accessCount_(1), weight_(1), list_(myArcList::T1), pinned_(false), next_(nullptr), prev_(nullptr) {}
 
         // 有参构造
         myArcCacheNode(KEY key, VALUE value)
-            : key_(key), value_(value), accessCount_(1), next_(nullptr)
+            : key_(key), value_(value), accessCount_(1), weight_(1), list_(myArcList::T1), pinned_(false), next_(nullptr), prev_(nullptr)
         {
         }
 
@@ -62,13 +66,33 @@ namespace myCacheSystem
             ++accessCount_;
         }
 
+        size_t getWeight() const
+        {
+            return weight_;
+        }
+
+        myArcList getList() const
+        {
+            return list_;
+        }
+
+        // 释放键值，结点归还 myNodePool 时调用，空闲栈中的结点不再占用键值的内存
+        void releasePayload()
+        {
+            key_ = KEY();
+            value_ = VALUE();
+        }
+
     private:
         KEY key_;
         VALUE value_;
-        size_t accessCount_; // 访问次数
-        std::shared_ptr<myArcCacheNode> next_;
-        std::weak_ptr<myArcCacheNode> prev_;
+        size_t accessCount_;   // 访问次数
+        size_t weight_;        // 权重，淘汰时记入幽灵链表，用于按权重调整目标大小
+        myArcList list_;       // 所在链表
+        bool pinned_;          // 是否交出过句柄(getHandle)，为true时不能原地修改或立即复用
+        myArcCacheNode *next_; // 结点由myNodePool统一管理，使用裸指针侵入式链接
+        myArcCacheNode *prev_;
     };
 }
 
-#endif // MYARCCACHENODE_H
\ No newline at end of file
+#endif // MYARCCACHENODE_H
@@ -0,0 +1,132 @@
+#ifndef MYCACHEAWAITABLE_H
+#define MYCACHEAWAITABLE_H
+
+#include <coroutine>
+#include <exception>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include "myExecutor.h"
+
+namespace myCacheSystem
+{
+    /*
+        缓存协程接口返回的 awaitable，T 为 co_await 的结果类型
+        OP 描述一次缓存操作，需要提供：
+        1. bool tryNow(Result &result)：不阻塞地尝试完成操作，完成时写入 result 并返回true(协程不挂起)
+        2. void start(Completion completion)：协程挂起后开始异步执行，结束时调用 completion 的 setValue/setError/run，
+           协程随后在 executor 的工作线程上恢复；start 返回前协程可能已经在其他线程恢复，返回之前不能再访问 awaitable
+        awaitable 拥有 OP(及其中拷贝的key/value)，在 co_await 之前不执行任何操作
+    */
+    template <typename T, typename OP>
+    class myCacheAwaitable
+    {
+    public:
+        using Result = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+        // 异步完成通知
+        class Completion
+        {
+        public:
+            explicit Completion(myCacheAwaitable *awaitable) : awaitable_(awaitable) {}
+
+            void setValue(Result value) const
+            {
+                awaitable_->result_ = std::move(value);
+                resume();
+            }
+
+            void setError(std::exception_ptr error) const
+            {
+                awaitable_->error_ = error;
+                resume();
+            }
+
+            // 执行 fn，把它的返回值(或异常)作为结果
+            template <typename FN>
+            void run(FN &&fn) const
+            {
+                try
+                {
+                    if constexpr (std::is_void_v<T>)
+                    {
+                        fn();
+                    }
+                    else
+                    {
+                        awaitable_->result_ = fn();
+                    }
+                }
+                catch (...)
+                {
+                    awaitable_->error_ = std::current_exception();
+                }
+                resume();
+            }
+
+            myExecutor &executor() const
+            {
+                return awaitable_->executor_;
+            }
+
+        private:
+            void resume() const
+            {
+                awaitable_->executor_.resume(awaitable_->handle_);
+            }
+
+            myCacheAwaitable *awaitable_;
+        };
+
+        /*
+            构造函数
+        */
+        myCacheAwaitable(OP op, myExecutor &executor)
+            : op_(std::move(op)), executor_(executor), result_()
+        {
+        }
+
+        /*
+            awaitable 接口
+        */
+        bool await_ready()
+        {
+            try
+            {
+                return op_.tryNow(result_);
+            }
+            catch (...)
+            {
+                error_ = std::current_exception();
+                return true;
+            }
+        }
+
+        void await_suspend(std::coroutine_handle<> handle)
+        {
+            handle_ = handle;
+            op_.start(Completion(this));
+        }
+
+        T await_resume()
+        {
+            if (error_)
+            {
+                std::rethrow_exception(error_);
+            }
+            if constexpr (!std::is_void_v<T>)
+            {
+                return std::move(result_);
+            }
+        }
+
+    private:
+        OP op_;                         // 缓存操作
+        myExecutor &executor_;          // 恢复协程的线程池
+        std::coroutine_handle<> handle_; // 挂起的协程
+        Result result_;                 // 操作结果
+        std::exception_ptr error_;      // 操作抛出的异常
+    };
+} // namespace myCacheSystem
+
+#endif // MYCACHEAWAITABLE_H
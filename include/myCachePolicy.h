@@ -1,8 +1,54 @@
 #ifndef MYCACHEPOLICY_H
 #define MYCACHEPOLICY_H
 
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <span>
+#include <variant>
+#include <vector>
+#include "mySingleFlight.h"
+#include "myExecutor.h"
+#include "myCacheAwaitable.h"
+
 namespace myCacheSystem
 {
+    /*
+        权重函数：返回一个缓存项的权重(如占用的字节数)
+        支持权重的缓存以 capacity 作为权重预算；权重函数为空时每个缓存项权重为1，capacity 即缓存项数量
+    */
+    template <typename KEY, typename VALUE>
+    using myWeigher = std::function<size_t(const KEY &, const VALUE &)>;
+
+    /*
+        非阻塞查询的结果：Busy 表示需要的锁正被其他线程持有，查询没有执行
+    */
+    enum class myTryStatus : uint8_t
+    {
+        Hit,
+        Miss,
+        Busy
+    };
+
+    // 加锁：TRY 为 true 时只尝试一次，锁被占用时返回false；lock 以 std::defer_lock 构造
+    template <bool TRY, typename LOCK>
+    bool myAcquireLock(LOCK &lock)
+    {
+        if constexpr (TRY)
+        {
+            return lock.try_lock();
+        }
+        else
+        {
+            lock.lock();
+            return true;
+        }
+    }
+
     /*
         抽象基类，缓存池
     */
@@ -18,15 +64,289 @@ namespace myCacheSystem
         /*
             纯虚函数接口
         */
-        // 添加缓存
-        virtual void put(KEY key, VALUE value) = 0;
+        // 添加缓存(拷贝键值)
+        virtual void put(const KEY &key, const VALUE &value) = 0;
+
+        // 添加缓存(移动键值，避免拷贝)
+        virtual void put(KEY &&key, VALUE &&value) = 0;
+
+        // 添加带过期时间的缓存，ttl 之后读取视为未命中；不带 ttl 的 put 会清除已有的过期时间
+        virtual void put(const KEY &key, const VALUE &value, std::chrono::milliseconds ttl) = 0;
+
+        virtual void put(KEY &&key, VALUE &&value, std::chrono::milliseconds ttl) = 0;
 
         // 获取value
-        virtual bool get(KEY key, VALUE &value) = 0;
+        virtual bool get(const KEY &key, VALUE &value) = 0;
 
         // 访问缓存数据函数
-        virtual VALUE get(KEY key) = 0;
+        virtual VALUE get(const KEY &key) = 0;
+
+        /*
+            批量接口
+            values、hits 与 keys 下标一一对应，返回命中数量
+            默认逐个调用 get/put，具体缓存可以重写为一次加锁批量处理
+        */
+        virtual size_t getMany(std::span<const KEY> keys, std::span<VALUE> values, std::vector<bool> &hits)
+        {
+            hits.assign(keys.size(), false);
+            size_t hitCount = 0;
+            for (size_t i = 0; i < keys.size(); ++i)
+            {
+                if (this->get(keys[i], values[i]))
+                {
+                    hits[i] = true;
+                    ++hitCount;
+                }
+            }
+            return hitCount;
+        }
+
+        virtual void putMany(std::span<const KEY> keys, std::span<const VALUE> values)
+        {
+            for (size_t i = 0; i < keys.size(); ++i)
+            {
+                this->put(keys[i], values[i]);
+            }
+        }
+
+        /*
+            非阻塞接口：需要的锁被其他线程持有时不等待，tryGet 返回 Busy、tryPut 返回false，操作没有执行
+            供协程接口在锁空闲时直接在当前线程完成操作；默认实现总是返回 Busy，协程接口会把操作交给 executor 执行阻塞版本
+        */
+        virtual myTryStatus tryGet(const KEY &, VALUE &)
+        {
+            return myTryStatus::Busy;
+        }
+
+        virtual bool tryPut(const KEY &, const VALUE &)
+        {
+            return false;
+        }
+
+        virtual bool tryPut(const KEY &, const VALUE &, std::chrono::milliseconds)
+        {
+            return false;
+        }
+
+        /*
+            通用接口
+        */
+        // 原地构造value后移动进缓存
+        template <typename... ARGS>
+        void emplace(KEY key, ARGS &&...args)
+        {
+            this->put(std::move(key), VALUE(std::forward<ARGS>(args)...));
+        }
+
+        /*
+            读取缓存，未命中时调用 loader(key) 加载并写入缓存
+            同一个key同时只有一个线程执行 loader，其他未命中的线程等待同一个结果；loader 执行期间不持有缓存(及分片)的锁
+            loader 抛出的异常传给所有等待的线程，结果不写入缓存；loader 不能对同一个key递归调用 getOrLoad
+        */
+        template <typename LOADER>
+        VALUE getOrLoad(const KEY &key, LOADER &&loader)
+        {
+            return this->loadThrough(key, loader, [this](const KEY &k, const VALUE &value)
+                                     { this->put(k, value); });
+        }
+
+        // 加载的结果带过期时间写入缓存
+        template <typename LOADER>
+        VALUE getOrLoad(const KEY &key, LOADER &&loader, std::chrono::milliseconds ttl)
+        {
+            return this->loadThrough(key, loader, [this, ttl](const KEY &k, const VALUE &value)
+                                     { this->put(k, value, ttl); });
+        }
+
+        /*
+            协程接口，返回 awaitable(见 myCacheAwaitable)，不会阻塞调用线程：
+            1. 先调用非阻塞的 tryGet/tryPut，锁空闲时在当前线程直接完成，协程不挂起
+            2. 锁被占用时挂起协程，由 executor 的工作线程执行阻塞版本，完成后在工作线程上恢复协程
+            3. getOrLoadAsync 未命中时挂起协程并登记到合并加载的登记表，loader 在 executor 上执行；
+               等待同一个key的协程只登记回调，不占用任何线程，加载完成后都在工作线程上恢复
+            key、value 和 loader 拷贝进 awaitable；缓存必须比挂起的协程存活得更久
+        */
+        // co_await 的结果为 std::optional<VALUE>，未命中时为空
+        auto getAsync(const KEY &key, myExecutor &executor = myExecutor::defaultExecutor())
+        {
+            return myCacheAwaitable<std::optional<VALUE>, GetOp>(GetOp{this, key}, executor);
+        }
+
+        auto putAsync(KEY key, VALUE value, myExecutor &executor = myExecutor::defaultExecutor())
+        {
+            return myCacheAwaitable<void, PutOp>(PutOp{this, std::move(key), std::move(value), std::nullopt}, executor);
+        }
+
+        auto putAsync(KEY key, VALUE value, std::chrono::milliseconds ttl, myExecutor &executor = myExecutor::defaultExecutor())
+        {
+            return myCacheAwaitable<void, PutOp>(PutOp{this, std::move(key), std::move(value), ttl}, executor);
+        }
+
+        // co_await 的结果为 VALUE，loader 抛出的异常在 co_await 处重新抛出
+        template <typename LOADER>
+        auto getOrLoadAsync(const KEY &key, LOADER loader, myExecutor &executor = myExecutor::defaultExecutor())
+        {
+            return myCacheAwaitable<VALUE, LoadOp<LOADER>>(LoadOp<LOADER>{this, key, std::move(loader), std::nullopt}, executor);
+        }
+
+        template <typename LOADER>
+        auto getOrLoadAsync(const KEY &key, LOADER loader, std::chrono::milliseconds ttl, myExecutor &executor = myExecutor::defaultExecutor())
+        {
+            return myCacheAwaitable<VALUE, LoadOp<LOADER>>(LoadOp<LOADER>{this, key, std::move(loader), ttl}, executor);
+        }
+
+    private:
+        using TTL = std::optional<std::chrono::milliseconds>;
+
+        // getAsync：锁被占用时在工作线程上执行 get
+        struct GetOp
+        {
+            myCachePolicy *cache_;
+            KEY key_;
+
+            bool tryNow(std::optional<VALUE> &result)
+            {
+                VALUE value{};
+                myTryStatus status = cache_->tryGet(key_, value);
+                if (status == myTryStatus::Hit)
+                {
+                    result.emplace(std::move(value));
+                }
+                return status != myTryStatus::Busy;
+            }
+
+            template <typename COMPLETION>
+            void start(COMPLETION completion)
+            {
+                completion.executor().post([this, completion]()
+                                           { completion.run([this]()
+                                                            {
+                    std::optional<VALUE> result;
+                    VALUE value{};
+                    if (cache_->get(key_, value))
+                    {
+                        result.emplace(std::move(value));
+                    }
+                    return result; }); });
+            }
+        };
+
+        // putAsync：锁被占用时在工作线程上执行 put
+        struct PutOp
+        {
+            myCachePolicy *cache_;
+            KEY key_;
+            VALUE value_;
+            TTL ttl_;
+
+            bool tryNow(std::monostate &)
+            {
+                return ttl_ ? cache_->tryPut(key_, value_, *ttl_) : cache_->tryPut(key_, value_);
+            }
+
+            template <typename COMPLETION>
+            void start(COMPLETION completion)
+            {
+                completion.executor().post([this, completion]()
+                                           { completion.run([this]()
+                                                            {
+                    if (ttl_)
+                    {
+                        cache_->put(std::move(key_), std::move(value_), *ttl_);
+                    }
+                    else
+                    {
+                        cache_->put(std::move(key_), std::move(value_));
+                    } }); });
+            }
+        };
+
+        // getOrLoadAsync：未命中(或锁被占用)时登记到合并加载的登记表
+        template <typename LOADER>
+        struct LoadOp
+        {
+            myCachePolicy *cache_;
+            KEY key_;
+            LOADER loader_;
+            TTL ttl_;
+
+            bool tryNow(VALUE &result)
+            {
+                return cache_->tryGet(key_, result) == myTryStatus::Hit;
+            }
+
+            template <typename COMPLETION>
+            void start(COMPLETION completion)
+            {
+                // 只有成为执行者时才会调用加载函数，此时协程一直挂起到加载结束，捕获 this 是安全的
+                cache_->singleFlight().runAsync(
+                    key_, [this]()
+                    { return cache_->loadMissing(key_, loader_, [this](const KEY &k, const VALUE &value)
+                                                 { cache_->store(k, value, ttl_); }); },
+                    [completion](const VALUE *value, std::exception_ptr error)
+                    {
+                        if (value)
+                        {
+                            completion.setValue(*value);
+                        }
+                        else
+                        {
+                            completion.setError(error);
+                        }
+                    },
+                    completion.executor());
+            }
+        };
+
+        template <typename LOADER, typename STORE>
+        VALUE loadThrough(const KEY &key, LOADER &loader, STORE &&store)
+        {
+            VALUE value{};
+            if (this->get(key, value))
+            {
+                return value;
+            }
+            return this->singleFlight().run(key, [&]()
+                                            { return this->loadMissing(key, loader, store); });
+        }
+
+        // 合并加载的执行者调用：上一次加载可能刚刚完成并写入缓存，先检查一次
+        template <typename LOADER, typename STORE>
+        VALUE loadMissing(const KEY &key, LOADER &loader, STORE &&store)
+        {
+            VALUE loaded{};
+            if (this->get(key, loaded))
+            {
+                return loaded;
+            }
+            loaded = loader(key);
+            store(key, loaded);
+            return loaded;
+        }
+
+        void store(const KEY &key, const VALUE &value, const TTL &ttl)
+        {
+            if (ttl)
+            {
+                this->put(key, value, *ttl);
+            }
+            else
+            {
+                this->put(key, value);
+            }
+        }
+
+        // 第一次未命中时才创建登记表
+        mySingleFlight<KEY, VALUE> &singleFlight()
+        {
+            std::call_once(singleFlightOnce_, [this]()
+                           { singleFlight_ = std::make_unique<mySingleFlight<KEY, VALUE>>(); });
+            return *singleFlight_;
+        }
+
+        std::once_flag singleFlightOnce_;                         // 保证登记表只创建一次
+        std::unique_ptr<mySingleFlight<KEY, VALUE>> singleFlight_; // 合并并发加载的登记表
     };
 } // namespace KamaCache
 
-#endif // MYCACHEPOLICY_H
\ No newline at end of file
+#endif // MYCACHEPOLICY_H
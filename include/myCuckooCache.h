@@ -0,0 +1,687 @@
+#ifndef MYCUCKOOCACHE_H
+#define MYCUCKOOCACHE_H
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <mutex>
+#include "myCachePolicy.h"
+#include "myHash.h"
+#include "myTimingWheel.h"
+#include "myEpochReclaimer.h"
+#include "myValueHandle.h"
+
+namespace myCacheSystem
+{
+    /*
+        基于分桶布谷鸟哈希表的并发缓存
+        1. 每个key有两个候选桶，每个桶4个槽位，一个桶占一个缓存行；槽位存放不可变的缓存项指针和8位指纹
+        2. 读操作不加锁：读取两个桶的版本号(顺序锁)，按指纹比对槽位；命中直接返回，
+           未命中时重新检查版本号，期间有写操作改动过这两个桶就重试；读到的缓存项由 myEpochReclaimer 保证不被提前释放
+        3. 写操作按桶号对条带锁加锁(两个候选桶按条带序号顺序加锁)，修改桶前后各把版本号加一
+        4. 两个候选桶都满时，尝试把其中一个缓存项挪到它的另一个候选桶(一步布谷鸟移动)，仍然没有空位就在这8个槽位内按CLOCK淘汰
+        5. 缓存项总数超过容量时，全局CLOCK指针扫过槽位：引用位为1的清零，为0的淘汰
+        命中只在引用位为0时写一次引用位，热点key的读操作不会反复写同一缓存行
+        缓存项不可变，更新时发布新的缓存项并回收旧的，因此每次写入需要一次堆分配；过期时间在读取时检查，不使用时间轮
+    */
+    template <typename KEY, typename VALUE>
+    class myCuckooCache : public myCachePolicy<KEY, VALUE>
+    {
+    public:
+        static constexpr size_t kSlotsPerBucket = 4;   // 每个桶的槽位数
+        static constexpr double kMaxLoadFactor = 0.85; // 按容量计算桶数时的最大装载率
+        static constexpr size_t kMaxStripes = 1024;    // 条带锁数量上限
+
+        /*
+            构造函数
+        */
+        // 桶数取使装载率不超过 kMaxLoadFactor 的最小2的幂，条带锁数量为 min(桶数, kMaxStripes)
+        explicit myCuckooCache(size_t capacity)
+            : capacity_(capacity),
+              bucketMask_(bucketCount(capacity) - 1),
+              stripeMask_(std::min(bucketCount(capacity), kMaxStripes) - 1),
+              size_(0),
+              hand_(0)
+        {
+            buckets_ = std::make_unique<Bucket[]>(bucketMask_ + 1);
+            stripes_ = std::make_unique<Stripe[]>(stripeMask_ + 1);
+        }
+
+        ~myCuckooCache() override
+        {
+            for (size_t b = 0; b <= bucketMask_; ++b)
+            {
+                for (auto &entry : buckets_[b].entries_)
+                {
+                    delete entry.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /*
+            成员函数接口
+        */
+        // 添加缓存
+        virtual void put(const KEY &key, const VALUE &value) override
+        {
+            putImpl(key, value);
+        }
+
+        virtual void put(KEY &&key, VALUE &&value) override
+        {
+            putImpl(std::move(key), std::move(value));
+        }
+
+        // 添加带过期时间的缓存
+        virtual void put(const KEY &key, const VALUE &value, std::chrono::milliseconds ttl) override
+        {
+            putImpl(key, value, myTimingWheelDeadline(ttl));
+        }
+
+        virtual void put(KEY &&key, VALUE &&value, std::chrono::milliseconds ttl) override
+        {
+            putImpl(std::move(key), std::move(value), myTimingWheelDeadline(ttl));
+        }
+
+        // 获取value
+        virtual bool get(const KEY &key, VALUE &value) override
+        {
+            auto guard = reclaimer_.enter();
+            return getImpl(key, value);
+        }
+
+        virtual VALUE get(const KEY &key) override
+        {
+            VALUE value{};
+            auto guard = reclaimer_.enter();
+            getImpl(key, value);
+            return value;
+        }
+
+        // 透明查找：std::string 键可以直接用 std::string_view 查询
+        template <typename K, typename = std::enable_if_t<myIsTransparentKey_v<KEY, K>>>
+        bool get(const K &key, VALUE &value)
+        {
+            auto guard = reclaimer_.enter();
+            return getImpl(key, value);
+        }
+
+        template <typename K, typename = std::enable_if_t<myIsTransparentKey_v<KEY, K>>>
+        VALUE get(const K &key)
+        {
+            VALUE value{};
+            auto guard = reclaimer_.enter();
+            getImpl(key, value);
+            return value;
+        }
+
+        // 非阻塞接口：读不加锁，从不返回 Busy；写只尝试候选桶的条带锁
+        virtual myTryStatus tryGet(const KEY &key, VALUE &value) override
+        {
+            auto guard = reclaimer_.enter();
+            return getImpl(key, value) ? myTryStatus::Hit : myTryStatus::Miss;
+        }
+
+        virtual bool tryPut(const KEY &key, const VALUE &value) override
+        {
+            return putImpl<true>(key, value);
+        }
+
+        virtual bool tryPut(const KEY &key, const VALUE &value, std::chrono::milliseconds ttl) override
+        {
+            return putImpl<true>(key, value, myTimingWheelDeadline(ttl));
+        }
+
+        // 零拷贝读取：缓存项不可变且由纪元保护，句柄直接指向缓存项中的value，见 myValueHandle
+        template <typename K>
+        myValueHandle<VALUE> getHandle(const K &key)
+        {
+            auto guard = reclaimer_.enter();
+            const Entry *entry = findEntry(key);
+            return entry ? myValueHandle<VALUE>(std::move(guard), &entry->value_) : myValueHandle<VALUE>();
+        }
+
+        // 批量查询：整批只进入一次纪元临界区
+        virtual size_t getMany(std::span<const KEY> keys, std::span<VALUE> values, std::vector<bool> &hits) override
+        {
+            hits.assign(keys.size(), false);
+            auto guard = reclaimer_.enter();
+            size_t hitCount = 0;
+            for (size_t i = 0; i < keys.size(); ++i)
+            {
+                if (getImpl(keys[i], values[i]))
+                {
+                    hits[i] = true;
+                    ++hitCount;
+                }
+            }
+            return hitCount;
+        }
+
+        // 删除指定缓存项
+        template <typename K>
+        void remove(const K &key)
+        {
+            uint64_t hash = hashOf(key);
+            size_t first = primaryBucket(hash);
+            size_t second = alternateBucket(first, hash);
+            Entry *removed = nullptr;
+            {
+                StripeLock lock(*this, first, second);
+                for (size_t b : {first, second})
+                {
+                    size_t slot = findLocked(buckets_[b], hash, key);
+                    if (slot != kSlotsPerBucket)
+                    {
+                        removed = takeSlot(buckets_[b], slot);
+                        size_.fetch_sub(1, std::memory_order_relaxed);
+                        break;
+                    }
+                }
+            }
+            reclaimer_.retire(removed);
+        }
+
+        // 清空缓存，按顺序持有全部条带锁
+        void clear()
+        {
+            for (size_t s = 0; s <= stripeMask_; ++s)
+            {
+                stripes_[s].mutex_.lock();
+            }
+            for (size_t b = 0; b <= bucketMask_; ++b)
+            {
+                for (size_t slot = 0; slot < kSlotsPerBucket; ++slot)
+                {
+                    if (buckets_[b].entries_[slot].load(std::memory_order_relaxed))
+                    {
+                        reclaimer_.retire(takeSlot(buckets_[b], slot));
+                    }
+                }
+            }
+            size_.store(0, std::memory_order_relaxed);
+            for (size_t s = stripeMask_ + 1; s-- > 0;)
+            {
+                stripes_[s].mutex_.unlock();
+            }
+        }
+
+        // 缓存项数量(并发写入时为近似值)
+        size_t size() const
+        {
+            return std::min(size_.load(std::memory_order_relaxed), capacity_);
+        }
+
+        // 桶数
+        size_t buckets() const
+        {
+            return bucketMask_ + 1;
+        }
+
+    private:
+        // 不可变的缓存项，更新时整体替换
+        struct Entry
+        {
+            KEY key_;
+            VALUE value_;
+            uint64_t hash_;       // 完整哈希值，用于计算另一个候选桶
+            uint64_t expireTick_; // 过期刻度，0表示不过期
+        };
+
+        // 一个桶占一个缓存行：版本号、指纹、引用位和缓存项指针
+        struct alignas(64) Bucket
+        {
+            std::atomic<uint32_t> version_{0};                   // 顺序锁版本号，奇数表示正在修改
+            std::atomic<uint8_t> tags_[kSlotsPerBucket] = {};       // 8位指纹，只用于快速过滤
+            std::atomic<uint8_t> referenced_[kSlotsPerBucket] = {}; // CLOCK引用位
+            std::atomic<Entry *> entries_[kSlotsPerBucket] = {};    // 缓存项，空槽位为nullptr
+        };
+
+        // 条带锁，各占一个缓存行
+        struct alignas(64) Stripe
+        {
+            std::mutex mutex_;
+        };
+
+        // 持有两个候选桶对应的条带锁，按条带序号顺序加锁避免死锁
+        class StripeLock
+        {
+        public:
+            StripeLock(myCuckooCache &cache, size_t first, size_t second)
+                : cache_(cache), owns_(true)
+            {
+                low_ = std::min(cache.stripeOf(first), cache.stripeOf(second));
+                high_ = std::max(cache.stripeOf(first), cache.stripeOf(second));
+                cache_.stripes_[low_].mutex_.lock();
+                if (high_ != low_)
+                {
+                    cache_.stripes_[high_].mutex_.lock();
+                }
+            }
+
+            // 只尝试加锁，任一条带锁被占用时不持有任何锁，owns() 返回false
+            StripeLock(myCuckooCache &cache, size_t first, size_t second, std::try_to_lock_t)
+                : cache_(cache), owns_(false)
+            {
+                low_ = std::min(cache.stripeOf(first), cache.stripeOf(second));
+                high_ = std::max(cache.stripeOf(first), cache.stripeOf(second));
+                if (!cache_.stripes_[low_].mutex_.try_lock())
+                {
+                    return;
+                }
+                if (high_ != low_ && !cache_.stripes_[high_].mutex_.try_lock())
+                {
+                    cache_.stripes_[low_].mutex_.unlock();
+                    return;
+                }
+                owns_ = true;
+            }
+
+            ~StripeLock()
+            {
+                if (!owns_)
+                {
+                    return;
+                }
+                if (high_ != low_)
+                {
+                    cache_.stripes_[high_].mutex_.unlock();
+                }
+                cache_.stripes_[low_].mutex_.unlock();
+            }
+
+            bool owns() const
+            {
+                return owns_;
+            }
+
+            bool holds(size_t stripe) const
+            {
+                return stripe == low_ || stripe == high_;
+            }
+
+        private:
+            myCuckooCache &cache_;
+            size_t low_;
+            size_t high_;
+            bool owns_; // 是否持有锁
+        };
+
+        /*
+            私有成员函数方法
+        */
+        static size_t bucketCount(size_t capacity)
+        {
+            size_t needed = static_cast<size_t>(capacity / (kSlotsPerBucket * kMaxLoadFactor)) + 1;
+            return std::max<size_t>(std::bit_ceil(needed), 2);
+        }
+
+        template <typename K>
+        static uint64_t hashOf(const K &key)
+        {
+            return myHashMix(myKeyHash<KEY>{}(key));
+        }
+
+        static uint8_t tagOf(uint64_t hash)
+        {
+            return static_cast<uint8_t>(hash >> 56);
+        }
+
+        size_t primaryBucket(uint64_t hash) const
+        {
+            return hash & bucketMask_;
+        }
+
+        // 另一个候选桶：与哈希高位的奇数异或，两个候选桶一定不同，且互为对方的候选桶
+        size_t alternateBucket(size_t bucket, uint64_t hash) const
+        {
+            return (bucket ^ ((hash >> 32) | 1)) & bucketMask_;
+        }
+
+        size_t stripeOf(size_t bucket) const
+        {
+            return bucket & stripeMask_;
+        }
+
+        // 开始/结束修改桶(调用者持有桶的条带锁)
+        static void beginWrite(Bucket &bucket)
+        {
+            bucket.version_.store(bucket.version_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+        }
+
+        static void endWrite(Bucket &bucket)
+        {
+            bucket.version_.store(bucket.version_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        // 在桶中查找key，没有锁保护，返回的缓存项在纪元临界区内有效
+        template <typename K>
+        static Entry *findOptimistic(Bucket &bucket, uint64_t hash, const K &key, size_t &slot)
+        {
+            uint8_t tag = tagOf(hash);
+            for (slot = 0; slot < kSlotsPerBucket; ++slot)
+            {
+                if (bucket.tags_[slot].load(std::memory_order_relaxed) != tag)
+                {
+                    continue;
+                }
+                Entry *entry = bucket.entries_[slot].load(std::memory_order_acquire);
+                if (entry && entry->hash_ == hash && entry->key_ == key)
+                {
+                    return entry;
+                }
+            }
+            return nullptr;
+        }
+
+        // 在桶中查找key，返回槽位，未找到返回 kSlotsPerBucket(调用者持有桶的条带锁)
+        template <typename K>
+        static size_t findLocked(Bucket &bucket, uint64_t hash, const K &key)
+        {
+            for (size_t slot = 0; slot < kSlotsPerBucket; ++slot)
+            {
+                Entry *entry = bucket.entries_[slot].load(std::memory_order_relaxed);
+                if (entry && entry->hash_ == hash && entry->key_ == key)
+                {
+                    return slot;
+                }
+            }
+            return kSlotsPerBucket;
+        }
+
+        // 空槽位，没有返回 kSlotsPerBucket(调用者持有桶的条带锁)
+        static size_t freeSlot(Bucket &bucket)
+        {
+            for (size_t slot = 0; slot < kSlotsPerBucket; ++slot)
+            {
+                if (!bucket.entries_[slot].load(std::memory_order_relaxed))
+                {
+                    return slot;
+                }
+            }
+            return kSlotsPerBucket;
+        }
+
+        // 把缓存项放入槽位，返回原来的缓存项(调用者持有桶的条带锁)
+        static Entry *storeSlot(Bucket &bucket, size_t slot, Entry *entry, uint8_t referenced)
+        {
+            beginWrite(bucket);
+            Entry *old = bucket.entries_[slot].load(std::memory_order_relaxed);
+            bucket.tags_[slot].store(tagOf(entry->hash_), std::memory_order_relaxed);
+            bucket.referenced_[slot].store(referenced, std::memory_order_relaxed);
+            bucket.entries_[slot].store(entry, std::memory_order_release);
+            endWrite(bucket);
+            return old;
+        }
+
+        // 清空槽位，返回原来的缓存项(调用者持有桶的条带锁)
+        static Entry *takeSlot(Bucket &bucket, size_t slot)
+        {
+            beginWrite(bucket);
+            Entry *old = bucket.entries_[slot].load(std::memory_order_relaxed);
+            bucket.entries_[slot].store(nullptr, std::memory_order_relaxed);
+            bucket.tags_[slot].store(0, std::memory_order_relaxed);
+            bucket.referenced_[slot].store(0, std::memory_order_relaxed);
+            endWrite(bucket);
+            return old;
+        }
+
+        // 无锁读(调用者已进入纪元临界区)
+        template <typename K>
+        bool getImpl(const K &key, VALUE &value)
+        {
+            const Entry *entry = findEntry(key);
+            if (!entry)
+            {
+                return false;
+            }
+            value = entry->value_;
+            return true;
+        }
+
+        // 无锁查找未过期的缓存项并设置引用位，未命中返回nullptr(调用者已进入纪元临界区)
+        template <typename K>
+        const Entry *findEntry(const K &key)
+        {
+            if (capacity_ <= 0)
+                return nullptr;
+
+            uint64_t hash = hashOf(key);
+            Bucket &first = buckets_[primaryBucket(hash)];
+            Bucket &second = buckets_[alternateBucket(primaryBucket(hash), hash)];
+            for (;;)
+            {
+                uint32_t firstVersion = first.version_.load(std::memory_order_acquire);
+                uint32_t secondVersion = second.version_.load(std::memory_order_acquire);
+                if ((firstVersion | secondVersion) & 1)
+                {
+                    // 有写操作正在修改候选桶
+                    continue;
+                }
+
+                size_t slot = 0;
+                Bucket *bucket = &first;
+                Entry *entry = findOptimistic(first, hash, key, slot);
+                if (!entry)
+                {
+                    bucket = &second;
+                    entry = findOptimistic(second, hash, key, slot);
+                }
+                if (entry)
+                {
+                    // 缓存项不可变且不会被提前释放，读到即是某一时刻的有效值，不需要再检查版本号
+                    if (isExpired(entry))
+                    {
+                        return nullptr;
+                    }
+                    if (!bucket->referenced_[slot].load(std::memory_order_relaxed))
+                    {
+                        bucket->referenced_[slot].store(1, std::memory_order_relaxed);
+                    }
+                    return entry;
+                }
+
+                // 未命中：两个桶在扫描期间都没有被修改过，说明key确实不在表中(没有被移动到已扫描过的桶)
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (first.version_.load(std::memory_order_relaxed) == firstVersion &&
+                    second.version_.load(std::memory_order_relaxed) == secondVersion)
+                {
+                    return nullptr;
+                }
+            }
+        }
+
+        // TRY 为 true 时候选桶的条带锁被占用直接返回false(淘汰时仍可能短暂等待被淘汰项所在的条带锁)
+        template <bool TRY = false, typename K, typename V>
+        bool putImpl(K &&key, V &&value, uint64_t expireTick = 0)
+        {
+            if (capacity_ <= 0)
+                return true;
+
+            uint64_t hash = hashOf(key);
+            size_t first = primaryBucket(hash);
+            size_t second = alternateBucket(first, hash);
+            // 在锁外构造缓存项
+            Entry *entry = new Entry{std::forward<K>(key), std::forward<V>(value), hash, expireTick};
+            Entry *replaced = nullptr;
+            bool inserted = false;
+            if constexpr (TRY)
+            {
+                StripeLock lock(*this, first, second, std::try_to_lock);
+                if (!lock.owns())
+                {
+                    delete entry;
+                    return false;
+                }
+                replaced = insertLocked(lock, first, second, entry, inserted);
+            }
+            else
+            {
+                StripeLock lock(*this, first, second);
+                replaced = insertLocked(lock, first, second, entry, inserted);
+            }
+            reclaimer_.retire(replaced);
+
+            if (inserted && size_.fetch_add(1, std::memory_order_relaxed) + 1 > capacity_)
+            {
+                evictToCapacity();
+            }
+            return true;
+        }
+
+        // 放入缓存项，返回被替换或被淘汰的缓存项；占用了空槽位时 inserted 为true(调用者持有两个候选桶的条带锁)
+        Entry *insertLocked(StripeLock &lock, size_t first, size_t second, Entry *entry, bool &inserted)
+        {
+            // 已存在：替换为新的缓存项，按一次命中处理
+            for (size_t b : {first, second})
+            {
+                size_t slot = findLocked(buckets_[b], entry->hash_, entry->key_);
+                if (slot != kSlotsPerBucket)
+                {
+                    return storeSlot(buckets_[b], slot, entry, 1);
+                }
+            }
+
+            // 候选桶有空槽位
+            for (size_t b : {first, second})
+            {
+                size_t slot = freeSlot(buckets_[b]);
+                if (slot != kSlotsPerBucket)
+                {
+                    storeSlot(buckets_[b], slot, entry, 0);
+                    inserted = true;
+                    return nullptr;
+                }
+            }
+
+            // 一步布谷鸟移动：把某个缓存项挪到它的另一个候选桶，腾出槽位
+            for (size_t b : {first, second})
+            {
+                for (size_t slot = 0; slot < kSlotsPerBucket; ++slot)
+                {
+                    if (relocate(lock, b, slot))
+                    {
+                        storeSlot(buckets_[b], slot, entry, 0);
+                        inserted = true;
+                        return nullptr;
+                    }
+                }
+            }
+
+            // 8个槽位内按CLOCK淘汰：优先过期的缓存项，其次引用位为0的，途经的引用位清零
+            size_t victimBucket = first;
+            size_t victimSlot = kSlotsPerBucket;
+            for (size_t b : {first, second})
+            {
+                for (size_t slot = 0; slot < kSlotsPerBucket && victimSlot == kSlotsPerBucket; ++slot)
+                {
+                    if (isExpired(buckets_[b].entries_[slot].load(std::memory_order_relaxed)))
+                    {
+                        victimBucket = b;
+                        victimSlot = slot;
+                    }
+                }
+            }
+            for (size_t b : {first, second})
+            {
+                for (size_t slot = 0; slot < kSlotsPerBucket && victimSlot == kSlotsPerBucket; ++slot)
+                {
+                    if (buckets_[b].referenced_[slot].load(std::memory_order_relaxed))
+                    {
+                        buckets_[b].referenced_[slot].store(0, std::memory_order_relaxed);
+                    }
+                    else
+                    {
+                        victimBucket = b;
+                        victimSlot = slot;
+                    }
+                }
+            }
+            if (victimSlot == kSlotsPerBucket)
+            {
+                victimSlot = 0;
+            }
+            return storeSlot(buckets_[victimBucket], victimSlot, entry, 0);
+        }
+
+        // 尝试把槽位中的缓存项挪到它的另一个候选桶(目标桶的条带锁只尝试加锁，避免死锁)
+        bool relocate(StripeLock &lock, size_t bucket, size_t slot)
+        {
+            Entry *entry = buckets_[bucket].entries_[slot].load(std::memory_order_relaxed);
+            size_t target = alternateBucket(bucket, entry->hash_);
+            size_t stripe = stripeOf(target);
+            bool owned = lock.holds(stripe);
+            if (!owned && !stripes_[stripe].mutex_.try_lock())
+            {
+                return false;
+            }
+            size_t targetSlot = freeSlot(buckets_[target]);
+            if (targetSlot != kSlotsPerBucket)
+            {
+                // 先写入目标桶再清空原槽位，读者在两次之间可能看到两份，但不会两边都看不到
+                storeSlot(buckets_[target], targetSlot, entry, buckets_[bucket].referenced_[slot].load(std::memory_order_relaxed));
+                takeSlot(buckets_[bucket], slot);
+            }
+            if (!owned)
+            {
+                stripes_[stripe].mutex_.unlock();
+            }
+            return targetSlot != kSlotsPerBucket;
+        }
+
+        // 全局CLOCK指针扫过槽位直到缓存项数量不超过容量：引用位为1的清零，为0或已过期的淘汰
+        // 扫描不加锁，只有淘汰时对所在桶的条带锁加锁并确认槽位没有变化
+        void evictToCapacity()
+        {
+            auto guard = reclaimer_.enter();
+            size_t slotMask = (bucketMask_ + 1) * kSlotsPerBucket - 1;
+            while (size_.load(std::memory_order_relaxed) > capacity_)
+            {
+                size_t position = hand_.fetch_add(1, std::memory_order_relaxed) & slotMask;
+                size_t bucket = position / kSlotsPerBucket;
+                size_t slot = position % kSlotsPerBucket;
+                Bucket &target = buckets_[bucket];
+                Entry *entry = target.entries_[slot].load(std::memory_order_acquire);
+                if (!entry)
+                {
+                    continue;
+                }
+                if (!isExpired(entry) && target.referenced_[slot].load(std::memory_order_relaxed))
+                {
+                    target.referenced_[slot].store(0, std::memory_order_relaxed);
+                    continue;
+                }
+                Entry *evicted = nullptr;
+                {
+                    std::lock_guard<std::mutex> lock(stripes_[stripeOf(bucket)].mutex_);
+                    // 纪元临界区内缓存项不会被释放，指针相同即槽位没有被替换
+                    if (target.entries_[slot].load(std::memory_order_relaxed) == entry)
+                    {
+                        evicted = takeSlot(target, slot);
+                        size_.fetch_sub(1, std::memory_order_relaxed);
+                    }
+                }
+                reclaimer_.retire(evicted);
+            }
+        }
+
+        // 缓存项是否已经过期
+        static bool isExpired(const Entry *entry)
+        {
+            return entry && entry->expireTick_ != 0 && entry->expireTick_ <= myTimingWheelNow();
+        }
+
+        size_t capacity_;                  // 总容量
+        size_t bucketMask_;                // 桶数 - 1
+        size_t stripeMask_;                // 条带锁数量 - 1
+        std::unique_ptr<Bucket[]> buckets_; // 桶数组
+        std::unique_ptr<Stripe[]> stripes_; // 条带锁
+        std::atomic<size_t> size_;         // 缓存项数量
+        std::atomic<size_t> hand_;         // 全局CLOCK指针
+        myEpochReclaimer reclaimer_;       // 延迟回收被替换、淘汰的缓存项
+    };
+} // namespace myCacheSystem
+
+#endif // MYCUCKOOCACHE_H
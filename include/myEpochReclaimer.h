@@ -0,0 +1,225 @@
+#ifndef MYEPOCHRECLAIMER_H
+#define MYEPOCHRECLAIMER_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <cstdint>
+#include <algorithm>
+#include "myHash.h"
+
+namespace myCacheSystem
+{
+    /*
+        基于纪元(epoch)的延迟回收，供无锁读的数据结构使用
+        1. 读者进入临界区时在当前纪元奇偶对应的计数器上加一，离开时减一；计数器按线程条带化，各占一个缓存行
+        2. 写者把摘下的对象连同当时的纪元放入回收列表，对象在纪元前进两次之后才释放：
+           纪元从 e 前进到 e+1 的条件是纪元 e-1 的读者已经全部离开，因此纪元到达 r+2 时，
+           纪元 r 及之前进入的读者都已离开，不可能再持有纪元 r 摘下的对象
+        3. 读者加计数后重新检查纪元，纪元已经变化就撤销重来，保证写者看到计数为0之后不会有读者以旧纪元进入
+        读者只做两次原子加减，不会阻塞；写者在 retire 时顺带尝试推进纪元，回收工作摊在写操作上
+    */
+    class myEpochReclaimer
+    {
+    public:
+        static constexpr size_t kSlotNumber = 64;       // 读者计数器条带数(2的幂)
+        static constexpr size_t kRetireThreshold = 64;  // 累积多少个待回收对象后尝试推进纪元
+
+        // 读者临界区，析构时离开
+        class Guard
+        {
+        public:
+            // 空的 Guard 不在任何临界区内
+            Guard() : counter_(nullptr) {}
+
+            explicit Guard(std::atomic<uint64_t> *counter) : counter_(counter) {}
+
+            Guard(Guard &&other) noexcept : counter_(other.counter_)
+            {
+                other.counter_ = nullptr;
+            }
+
+            Guard &operator=(Guard &&other) noexcept
+            {
+                if (this != &other)
+                {
+                    leave();
+                    counter_ = other.counter_;
+                    other.counter_ = nullptr;
+                }
+                return *this;
+            }
+
+            Guard(const Guard &) = delete;
+            Guard &operator=(const Guard &) = delete;
+
+            ~Guard()
+            {
+                leave();
+            }
+
+        private:
+            void leave()
+            {
+                if (counter_)
+                {
+                    counter_->fetch_sub(1, std::memory_order_release);
+                    counter_ = nullptr;
+                }
+            }
+
+            std::atomic<uint64_t> *counter_; // 进入时加一的计数器
+        };
+
+        /*
+            构造函数
+        */
+        myEpochReclaimer() : epoch_(2), pending_(0)
+        {
+            slots_ = std::make_unique<Slot[]>(kSlotNumber);
+        }
+
+        myEpochReclaimer(const myEpochReclaimer &) = delete;
+        myEpochReclaimer &operator=(const myEpochReclaimer &) = delete;
+
+        // 析构时不再有读者，释放所有待回收对象
+        ~myEpochReclaimer()
+        {
+            for (auto &list : retired_)
+            {
+                freeList(list);
+            }
+        }
+
+        /*
+            成员函数接口
+        */
+        // 进入读者临界区，Guard 存活期间读到的对象不会被释放
+        Guard enter()
+        {
+            Slot &slot = slots_[probe() & (kSlotNumber - 1)];
+            for (;;)
+            {
+                uint64_t epoch = epoch_.load(std::memory_order_seq_cst);
+                std::atomic<uint64_t> &counter = slot.readers_[epoch & 1];
+                counter.fetch_add(1, std::memory_order_seq_cst);
+                if (epoch_.load(std::memory_order_seq_cst) == epoch)
+                {
+                    return Guard(&counter);
+                }
+                // 纪元在加计数期间前进了，撤销后按新纪元重来
+                counter.fetch_sub(1, std::memory_order_release);
+            }
+        }
+
+        // 延迟释放已经从数据结构中摘下的对象
+        template <typename T>
+        void retire(T *object)
+        {
+            if (!object)
+            {
+                return;
+            }
+            // 保证摘下对象的写入先于读取纪元
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            std::lock_guard<std::mutex> lock(mutex_);
+            uint64_t epoch = epoch_.load(std::memory_order_seq_cst);
+            retired_[epoch % 3].push_back(Retired{object, [](void *p)
+                                                  { delete static_cast<T *>(p); }});
+            if (++pending_ >= kRetireThreshold)
+            {
+                tryAdvance();
+            }
+        }
+
+        /*
+            由调用者自己管理的对象(如结点池中的结点)：摘下时记录 retireEpoch()，
+            reclaimable() 返回true之后，摘下之前进入临界区的读者都已离开，对象可以复用
+        */
+        uint64_t retireEpoch()
+        {
+            // 保证摘下对象的写入先于读取纪元
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            return epoch_.load(std::memory_order_seq_cst);
+        }
+
+        bool reclaimable(uint64_t retiredEpoch)
+        {
+            if (epoch_.load(std::memory_order_acquire) >= retiredEpoch + 2)
+            {
+                return true;
+            }
+            std::lock_guard<std::mutex> lock(mutex_);
+            while (epoch_.load(std::memory_order_relaxed) < retiredEpoch + 2 && tryAdvance())
+            {
+            }
+            return epoch_.load(std::memory_order_relaxed) >= retiredEpoch + 2;
+        }
+
+        // 待回收对象数量
+        size_t pending() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return retired_[0].size() + retired_[1].size() + retired_[2].size();
+        }
+
+    private:
+        struct Retired
+        {
+            void *object_;
+            void (*deleter_)(void *);
+        };
+
+        // 读者计数器，按纪元奇偶各一个
+        struct alignas(64) Slot
+        {
+            std::atomic<uint64_t> readers_[2] = {0, 0};
+        };
+
+        // 上一个纪元的读者全部离开时纪元加一，释放两个纪元之前摘下的对象，返回是否前进(调用者持有 mutex_)
+        bool tryAdvance()
+        {
+            uint64_t epoch = epoch_.load(std::memory_order_relaxed);
+            size_t previous = (epoch - 1) & 1;
+            for (size_t i = 0; i < kSlotNumber; ++i)
+            {
+                if (slots_[i].readers_[previous].load(std::memory_order_seq_cst) != 0)
+                {
+                    return false;
+                }
+            }
+            epoch_.store(epoch + 1, std::memory_order_seq_cst);
+            std::vector<Retired> &expired = retired_[(epoch + 1 - 2) % 3];
+            pending_ -= expired.size();
+            freeList(expired);
+            return true;
+        }
+
+        static void freeList(std::vector<Retired> &list)
+        {
+            for (Retired &retired : list)
+            {
+                retired.deleter_(retired.object_);
+            }
+            list.clear();
+        }
+
+        // 每个线程固定映射到一个计数器条带
+        static size_t probe()
+        {
+            static thread_local size_t threadProbe = myHashMix(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+            return threadProbe;
+        }
+
+        std::atomic<uint64_t> epoch_;       // 全局纪元
+        std::unique_ptr<Slot[]> slots_;     // 读者计数器条带
+        mutable std::mutex mutex_;          // 保护回收列表
+        std::vector<Retired> retired_[3];   // 按纪元模3存放的待回收对象
+        size_t pending_;                    // 待回收对象数量
+    };
+} // namespace myCacheSystem
+
+#endif // MYEPOCHRECLAIMER_H
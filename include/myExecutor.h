@@ -0,0 +1,134 @@
+#ifndef MYEXECUTOR_H
+#define MYEXECUTOR_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace myCacheSystem
+{
+    /*
+        协程接口使用的小型线程池
+        1. 固定数量的工作线程从一个FIFO队列中取任务执行
+        2. 异步接口在锁被占用或需要等待加载时挂起协程，由工作线程完成阻塞的部分后在工作线程上恢复协程
+        3. 析构时执行完队列中剩余的任务再退出
+        defaultExecutor() 是进程内共享的默认实例，线程数为硬件线程数的一半(至少2个)
+    */
+    class myExecutor
+    {
+    public:
+        /*
+            构造函数
+        */
+        explicit myExecutor(size_t threads = defaultThreads()) : stopping_(false)
+        {
+            for (size_t i = 0; i < std::max<size_t>(threads, 1); ++i)
+            {
+                workers_.emplace_back([this]()
+                                      { this->workerLoop(); });
+            }
+        }
+
+        myExecutor(const myExecutor &) = delete;
+        myExecutor &operator=(const myExecutor &) = delete;
+
+        ~myExecutor()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stopping_ = true;
+            }
+            cond_.notify_all();
+            for (auto &worker : workers_)
+            {
+                worker.join();
+            }
+        }
+
+        /*
+            成员函数接口
+        */
+        // 提交任务
+        void post(std::function<void()> task)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                tasks_.push_back(std::move(task));
+            }
+            cond_.notify_one();
+        }
+
+        // 在工作线程上恢复协程
+        void resume(std::coroutine_handle<> handle)
+        {
+            post([handle]()
+                 { handle.resume(); });
+        }
+
+        // co_await executor.schedule() 把当前协程切换到工作线程上继续执行
+        auto schedule()
+        {
+            struct Awaitable
+            {
+                myExecutor &executor_;
+
+                bool await_ready() const noexcept { return false; }
+                void await_suspend(std::coroutine_handle<> handle) { executor_.resume(handle); }
+                void await_resume() const noexcept {}
+            };
+            return Awaitable{*this};
+        }
+
+        // 工作线程数
+        size_t threads() const
+        {
+            return workers_.size();
+        }
+
+        // 进程内共享的默认实例
+        static myExecutor &defaultExecutor()
+        {
+            static myExecutor executor;
+            return executor;
+        }
+
+    private:
+        static size_t defaultThreads()
+        {
+            return std::max(2u, std::thread::hardware_concurrency() / 2);
+        }
+
+        void workerLoop()
+        {
+            for (;;)
+            {
+                std::function<void()> task;
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    cond_.wait(lock, [this]()
+                               { return stopping_ || !tasks_.empty(); });
+                    if (tasks_.empty())
+                    {
+                        return;
+                    }
+                    task = std::move(tasks_.front());
+                    tasks_.pop_front();
+                }
+                task();
+            }
+        }
+
+        std::mutex mutex_;                        // 保护任务队列
+        std::condition_variable cond_;            // 通知工作线程
+        std::deque<std::function<void()>> tasks_; // 任务队列
+        bool stopping_;                           // 析构中
+        std::vector<std::thread> workers_;        // 工作线程
+    };
+} // namespace myCacheSystem
+
+#endif // MYEXECUTOR_H
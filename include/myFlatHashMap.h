@@ -0,0 +1,441 @@
+#ifndef MYFLATHASHMAP_H
+#define MYFLATHASHMAP_H
+
+#include <cstdint>
+#include <cstring>
+#include <bit>
+#include <memory>
+#include <new>
+#include <utility>
+#include "myHash.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MY_FLAT_HASH_MAP_SSE2 1
+#endif
+
+namespace myCacheSystem
+{
+    /*
+        开放寻址的扁平哈希表(Swiss table 风格)，作为各缓存策略 key -> 结点 的索引
+        1. 每个槽位对应一个控制字节：空(kEmpty)、已删除(kDeleted) 或 哈希值低7位的指纹(H2)
+        2. 控制字节按16个一组，用SSE2一次比较整组指纹，只有指纹相同的槽位才比较key；
+           没有SSE2时退化为逐字节比较
+        3. 键值对直接存放在连续的槽位数组中，没有 std::unordered_map 的桶指针和单独分配的链表结点，
+           一次命中通常只访问控制字节和槽位两个缓存行
+        4. 按组做三角数探测，组数为2的幂时可以遍历所有组；最大负载因子 7/8
+        注意：插入可能触发扩容，扩容后之前的迭代器和元素地址失效
+    */
+    template <typename KEY, typename MAPPED, typename HASH = myKeyHash<KEY>, typename EQUAL = myKeyEqual>
+    class myFlatHashMap
+    {
+    public:
+        // 槽位中存放的键值对
+        struct value_type
+        {
+            KEY first;
+            MAPPED second;
+        };
+
+        // 前向迭代器，跳过非满槽位
+        class iterator
+        {
+            friend class myFlatHashMap;
+
+        public:
+            iterator() : ctrl_(nullptr), ctrlEnd_(nullptr), slot_(nullptr) {}
+
+            value_type &operator*() const { return *slot_; }
+            value_type *operator->() const { return slot_; }
+
+            iterator &operator++()
+            {
+                ++ctrl_;
+                ++slot_;
+                skipEmpty();
+                return *this;
+            }
+
+            bool operator==(const iterator &other) const { return slot_ == other.slot_; }
+            bool operator!=(const iterator &other) const { return slot_ != other.slot_; }
+
+        private:
+            iterator(const int8_t *ctrl, const int8_t *ctrlEnd, value_type *slot)
+                : ctrl_(ctrl), ctrlEnd_(ctrlEnd), slot_(slot) {}
+
+            void skipEmpty()
+            {
+                while (ctrl_ != ctrlEnd_ && *ctrl_ < 0)
+                {
+                    ++ctrl_;
+                    ++slot_;
+                }
+            }
+
+            const int8_t *ctrl_;
+            const int8_t *ctrlEnd_;
+            value_type *slot_;
+        };
+
+        /*
+            构造函数
+        */
+        myFlatHashMap() : ctrl_(nullptr), slots_(nullptr), capacity_(0), size_(0), growthLeft_(0) {}
+
+        explicit myFlatHashMap(size_t expected) : myFlatHashMap() { reserve(expected); }
+
+        ~myFlatHashMap() { destroyAll(); }
+
+        myFlatHashMap(const myFlatHashMap &) = delete;
+        myFlatHashMap &operator=(const myFlatHashMap &) = delete;
+
+        /*
+            成员函数接口
+        */
+        iterator begin()
+        {
+            iterator it(ctrl_, ctrl_ + capacity_, slots_);
+            it.skipEmpty();
+            return it;
+        }
+
+        iterator end() { return iterator(ctrl_ + capacity_, ctrl_ + capacity_, slots_ + capacity_); }
+
+        size_t size() const { return size_; }
+
+        bool empty() const { return size_ == 0; }
+
+        size_t capacity() const { return capacity_; }
+
+        // 查找，支持透明查找键
+        template <typename K>
+        iterator find(const K &key)
+        {
+            if (size_ == 0)
+            {
+                return end();
+            }
+            size_t hash = hashOf(key);
+            int8_t h2 = H2(hash);
+            size_t group = H1(hash) & groupMask_;
+            for (size_t step = 1;; ++step)
+            {
+                Group g(ctrl_ + group * kGroupWidth);
+                for (uint32_t mask = g.match(h2); mask != 0; mask &= mask - 1)
+                {
+                    size_t index = group * kGroupWidth + std::countr_zero(mask);
+                    if (equal_(slots_[index].first, key))
+                    {
+                        return iteratorAt(index);
+                    }
+                }
+                // 组内有空位说明探测链到此为止
+                if (g.matchEmpty() != 0)
+                {
+                    return end();
+                }
+                group = (group + step) & groupMask_;
+            }
+        }
+
+        template <typename K>
+        bool contains(const K &key) { return find(key) != end(); }
+
+        // 不存在时插入，返回 (迭代器, 是否插入)
+        template <typename K, typename M>
+        std::pair<iterator, bool> emplace(K &&key, M &&mapped)
+        {
+            auto [index, found, h2] = findOrPrepareInsert(key);
+            if (found)
+            {
+                return {iteratorAt(index), false};
+            }
+            new (slots_ + index) value_type{KEY(std::forward<K>(key)), MAPPED(std::forward<M>(mapped))};
+            publishInsert(index, h2);
+            return {iteratorAt(index), true};
+        }
+
+        // 存在则赋值，不存在则插入
+        template <typename K, typename M>
+        std::pair<iterator, bool> insert_or_assign(K &&key, M &&mapped)
+        {
+            auto [index, found, h2] = findOrPrepareInsert(key);
+            if (found)
+            {
+                slots_[index].second = std::forward<M>(mapped);
+                return {iteratorAt(index), false};
+            }
+            new (slots_ + index) value_type{KEY(std::forward<K>(key)), MAPPED(std::forward<M>(mapped))};
+            publishInsert(index, h2);
+            return {iteratorAt(index), true};
+        }
+
+        template <typename K>
+        MAPPED &operator[](K &&key)
+        {
+            auto [index, found, h2] = findOrPrepareInsert(key);
+            if (!found)
+            {
+                new (slots_ + index) value_type{KEY(std::forward<K>(key)), MAPPED()};
+                publishInsert(index, h2);
+            }
+            return slots_[index].second;
+        }
+
+        // 删除迭代器指向的元素
+        void erase(iterator it)
+        {
+            size_t index = it.slot_ - slots_;
+            slots_[index].~value_type();
+            --size_;
+            // 所在组删除前仍有空位，说明没有探测链经过这一组，可以直接置空；否则留下删除标记
+            Group g(ctrl_ + (index & ~(kGroupWidth - 1)));
+            if (g.matchEmpty() != 0)
+            {
+                ctrl_[index] = kEmpty;
+                ++growthLeft_;
+            }
+            else
+            {
+                ctrl_[index] = kDeleted;
+            }
+        }
+
+        template <typename K>
+        size_t erase(const K &key)
+        {
+            iterator it = find(key);
+            if (it == end())
+            {
+                return 0;
+            }
+            erase(it);
+            return 1;
+        }
+
+        // 清空元素，保留容量
+        void clear()
+        {
+            if (capacity_ == 0)
+            {
+                return;
+            }
+            destroySlots();
+            std::memset(ctrl_, kEmpty, capacity_);
+            size_ = 0;
+            growthLeft_ = maxLoad(capacity_);
+        }
+
+        // 预留至少可容纳 expected 个元素的空间
+        void reserve(size_t expected)
+        {
+            size_t capacity = kGroupWidth;
+            while (maxLoad(capacity) < expected)
+            {
+                capacity <<= 1;
+            }
+            if (capacity > capacity_)
+            {
+                rehash(capacity);
+            }
+        }
+
+    private:
+        static constexpr size_t kGroupWidth = 16;
+        static constexpr int8_t kEmpty = -128;  // 0b10000000
+        static constexpr int8_t kDeleted = -2;  // 0b11111110
+
+        /*
+            一组16个控制字节，match 系列函数返回位掩码，第i位表示组内第i个槽位匹配
+        */
+        struct Group
+        {
+#ifdef MY_FLAT_HASH_MAP_SSE2
+            explicit Group(const int8_t *pos) : ctrl_(_mm_load_si128(reinterpret_cast<const __m128i *>(pos))) {}
+
+            uint32_t match(int8_t h2) const
+            {
+                return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_)));
+            }
+
+            uint32_t matchEmpty() const
+            {
+                return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(kEmpty), ctrl_)));
+            }
+
+            // 空位和删除标记的最高位都是1，满槽位的最高位是0
+            uint32_t matchEmptyOrDeleted() const
+            {
+                return static_cast<uint32_t>(_mm_movemask_epi8(ctrl_));
+            }
+
+            __m128i ctrl_;
+#else
+            explicit Group(const int8_t *pos) { std::memcpy(ctrl_, pos, kGroupWidth); }
+
+            uint32_t match(int8_t h2) const { return matchIf([h2](int8_t c) { return c == h2; }); }
+
+            uint32_t matchEmpty() const { return matchIf([](int8_t c) { return c == kEmpty; }); }
+
+            uint32_t matchEmptyOrDeleted() const { return matchIf([](int8_t c) { return c < 0; }); }
+
+            template <typename PRED>
+            uint32_t matchIf(PRED pred) const
+            {
+                uint32_t mask = 0;
+                for (size_t i = 0; i < kGroupWidth; ++i)
+                {
+                    mask |= static_cast<uint32_t>(pred(ctrl_[i])) << i;
+                }
+                return mask;
+            }
+
+            int8_t ctrl_[kGroupWidth];
+#endif
+        };
+
+        // 高位决定探测起点，低7位作为指纹
+        static size_t H1(size_t hash) { return hash >> 7; }
+        static int8_t H2(size_t hash) { return static_cast<int8_t>(hash & 0x7f); }
+
+        static size_t maxLoad(size_t capacity) { return capacity - capacity / 8; }
+
+        template <typename K>
+        size_t hashOf(const K &key) const
+        {
+            // std::hash 对整数是恒等映射，先混淆再拆分 H1/H2
+            return static_cast<size_t>(myHashMix(hash_(key)));
+        }
+
+        iterator iteratorAt(size_t index) { return iterator(ctrl_ + index, ctrl_ + capacity_, slots_ + index); }
+
+        // 沿探测序列找到第一个空位或删除标记
+        size_t findFirstNonFull(size_t hash) const
+        {
+            size_t group = H1(hash) & groupMask_;
+            for (size_t step = 1;; ++step)
+            {
+                Group g(ctrl_ + group * kGroupWidth);
+                uint32_t mask = g.matchEmptyOrDeleted();
+                if (mask != 0)
+                {
+                    return group * kGroupWidth + std::countr_zero(mask);
+                }
+                group = (group + step) & groupMask_;
+            }
+        }
+
+        // findOrPrepareInsert 的结果：found 为true时 index 是已有元素，否则是待插入的槽位和它的指纹
+        struct InsertPosition
+        {
+            size_t index;
+            bool found;
+            int8_t h2;
+        };
+
+        // 查找key，不存在时选好插入槽位(必要时扩容)但不占用；调用者构造元素成功后再调用 publishInsert，
+        // 构造抛出异常时表保持原状
+        template <typename K>
+        InsertPosition findOrPrepareInsert(const K &key)
+        {
+            iterator it = find(key);
+            if (it != end())
+            {
+                return {static_cast<size_t>(it.slot_ - slots_), true, 0};
+            }
+            size_t hash = hashOf(key);
+            if (capacity_ == 0)
+            {
+                rehash(kGroupWidth);
+            }
+            size_t index = findFirstNonFull(hash);
+            // 复用删除标记不消耗增长余量；空位用完时扩容(删除标记过多时原容量重建)
+            if (growthLeft_ == 0 && ctrl_[index] != kDeleted)
+            {
+                rehash(size_ * 2 <= maxLoad(capacity_) / 2 ? capacity_ : capacity_ * 2);
+                index = findFirstNonFull(hash);
+            }
+            return {index, false, H2(hash)};
+        }
+
+        // 槽位中的元素已经构造完成，占用控制字节并计数
+        void publishInsert(size_t index, int8_t h2)
+        {
+            if (ctrl_[index] == kEmpty)
+            {
+                --growthLeft_;
+            }
+            ctrl_[index] = h2;
+            ++size_;
+        }
+
+        // 以新容量重建，所有元素移动到新数组
+        void rehash(size_t newCapacity)
+        {
+            int8_t *oldCtrl = ctrl_;
+            value_type *oldSlots = slots_;
+            size_t oldCapacity = capacity_;
+
+            ctrl_ = static_cast<int8_t *>(::operator new(newCapacity, std::align_val_t(kGroupWidth)));
+            std::memset(ctrl_, kEmpty, newCapacity);
+            slots_ = std::allocator<value_type>().allocate(newCapacity);
+            capacity_ = newCapacity;
+            groupMask_ = newCapacity / kGroupWidth - 1;
+            growthLeft_ = maxLoad(newCapacity) - size_;
+
+            for (size_t i = 0; i < oldCapacity; ++i)
+            {
+                if (oldCtrl[i] >= 0)
+                {
+                    size_t hash = hashOf(oldSlots[i].first);
+                    size_t index = findFirstNonFull(hash);
+                    ctrl_[index] = H2(hash);
+                    new (slots_ + index) value_type(std::move(oldSlots[i]));
+                    oldSlots[i].~value_type();
+                }
+            }
+            if (oldCtrl)
+            {
+                ::operator delete(oldCtrl, std::align_val_t(kGroupWidth));
+                std::allocator<value_type>().deallocate(oldSlots, oldCapacity);
+            }
+        }
+
+        void destroySlots()
+        {
+            for (size_t i = 0; i < capacity_; ++i)
+            {
+                if (ctrl_[i] >= 0)
+                {
+                    slots_[i].~value_type();
+                }
+            }
+        }
+
+        void destroyAll()
+        {
+            if (!ctrl_)
+            {
+                return;
+            }
+            destroySlots();
+            ::operator delete(ctrl_, std::align_val_t(kGroupWidth));
+            std::allocator<value_type>().deallocate(slots_, capacity_);
+            ctrl_ = nullptr;
+            slots_ = nullptr;
+            capacity_ = 0;
+            size_ = 0;
+        }
+
+        int8_t *ctrl_;          // 控制字节数组(16字节对齐)
+        value_type *slots_;     // 槽位数组
+        size_t capacity_;       // 槽位数(16的倍数，2的幂)
+        size_t groupMask_ = 0;  // 组数 - 1
+        size_t size_;           // 元素数
+        size_t growthLeft_;     // 还能使用的空位数
+        HASH hash_;
+        EQUAL equal_;
+    };
+} // namespace myCacheSystem
+
+#endif // MYFLATHASHMAP_H
@@ -0,0 +1,132 @@
+#ifndef MYFREQUENCYSKETCH_H
+#define MYFREQUENCYSKETCH_H
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include "myHash.h"
+
+namespace myCacheSystem
+{
+    /*
+        4位计数的 Count-Min Sketch，用于估计key最近的访问频次(TinyLFU)
+        1. 每个计数器4位，最大15，一个 uint64_t 存16个计数器
+        2. 每个key通过哈希选中一个64字节的块(8个字)，4个计数器都落在这个块里，增减和估计只访问一个缓存行
+        3. 计数器加一和估计都没有分支：未饱和时加 1 << shift，饱和时加 0
+        4. 增加次数达到采样数(10倍容量)后所有计数器减半，老化掉历史频次；减半是对整个数组的移位和掩码，编译器可以自动向量化
+        sketch 本身不加锁，由所属缓存在锁内调用
+    */
+    template <typename KEY>
+    class myFrequencySketch
+    {
+    public:
+        static constexpr uint64_t kResetMask = 0x7777777777777777ULL; // 减半后清除每个计数器借入的高位
+        static constexpr uint64_t kOneMask = 0x1111111111111111ULL;   // 每个计数器的最低位
+
+        /*
+            构造函数
+        */
+        // capacity: 缓存容量，计数器数量取不小于容量的2的幂
+        explicit myFrequencySketch(size_t capacity)
+        {
+            size_t words = std::bit_ceil(std::max<size_t>(capacity, 8));
+            table_ = std::make_unique<uint64_t[]>(words);
+            tableSize_ = words;
+            blockMask_ = (words >> 3) - 1;
+            sampleSize_ = std::max<size_t>(capacity, 1) * 10;
+            size_ = 0;
+        }
+
+        myFrequencySketch(const myFrequencySketch &) = delete;
+        myFrequencySketch &operator=(const myFrequencySketch &) = delete;
+
+        /*
+            成员函数接口
+        */
+        // 记录一次访问
+        template <typename K>
+        void increment(const K &key)
+        {
+            uint64_t blockHash = spread(key);
+            uint64_t counterHash = rehash(blockHash);
+            size_t block = (blockHash & blockMask_) << 3;
+            uint64_t added = 0;
+            for (size_t i = 0; i < 4; ++i)
+            {
+                // 第i个计数器位于块内第i对字中的一个，8位哈希选出字和字内的计数器
+                uint64_t h = counterHash >> (i << 3);
+                size_t index = (h >> 1) & 15;
+                size_t word = block + (h & 1) + (i << 1);
+                size_t shift = index << 2;
+                uint64_t notFull = ((table_[word] >> shift) & 15) != 15;
+                table_[word] += notFull << shift;
+                added |= notFull;
+            }
+            size_ += added;
+            if (size_ >= sampleSize_)
+            {
+                reset();
+            }
+        }
+
+        // 估计访问频次(0~15)
+        template <typename K>
+        size_t frequency(const K &key) const
+        {
+            uint64_t blockHash = spread(key);
+            uint64_t counterHash = rehash(blockHash);
+            size_t block = (blockHash & blockMask_) << 3;
+            uint64_t freq = 15;
+            for (size_t i = 0; i < 4; ++i)
+            {
+                uint64_t h = counterHash >> (i << 3);
+                size_t index = (h >> 1) & 15;
+                size_t word = block + (h & 1) + (i << 1);
+                freq = std::min<uint64_t>(freq, (table_[word] >> (index << 2)) & 15);
+            }
+            return static_cast<size_t>(freq);
+        }
+
+        // 所有计数器减半
+        void reset()
+        {
+            size_t odd = 0;
+            for (size_t i = 0; i < tableSize_; ++i)
+            {
+                odd += std::popcount(table_[i] & kOneMask);
+                table_[i] = (table_[i] >> 1) & kResetMask;
+            }
+            // 奇数计数器减半时各丢掉0.5
+            size_ = (size_ - std::min(size_, odd >> 2)) >> 1;
+        }
+
+        void clear()
+        {
+            std::fill(table_.get(), table_.get() + tableSize_, 0);
+            size_ = 0;
+        }
+
+    private:
+        template <typename K>
+        static uint64_t spread(const K &key)
+        {
+            myKeyHash<KEY> hashFunc;
+            return myHashMix(hashFunc(key));
+        }
+
+        // 计数器哈希取混淆后的高32位，与选块用的低位互不相关
+        static uint64_t rehash(uint64_t hash)
+        {
+            return std::rotr(hash, 32);
+        }
+
+        std::unique_ptr<uint64_t[]> table_; // 计数器数组
+        size_t tableSize_;                  // 字数(2的幂，至少8)
+        size_t blockMask_;                  // 块数 - 1
+        size_t sampleSize_;                 // 采样数，增加次数达到后减半
+        size_t size_;                       // 当前采样周期内的增加次数
+    };
+} // namespace myCacheSystem
+
+#endif // MYFREQUENCYSKETCH_H
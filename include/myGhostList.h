@@ -0,0 +1,177 @@
+#ifndef MYGHOSTLIST_H
+#define MYGHOSTLIST_H
+
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include "myHash.h"
+#include "myFlatHashMap.h"
+
+namespace myCacheSystem
+{
+    /*
+        幽灵链表：只记录最近被淘汰的key，不保存value
+        1. 每个条目只有key的64位指纹和权重(16字节)，按淘汰顺序放在环形数组里，FIFO淘汰
+        2. 指纹到环形数组序号的平铺哈希表用于查找，命中后直接从哈希表删除，环形数组中的条目变成失效条目，
+           出队或者整理时跳过
+        3. 环形数组满时，失效条目过半就原地整理，否则扩容一倍，均摊 O(1)
+        容量以权重为单位，与主缓存容量相互独立；不同key的指纹相同的概率约为 n / 2^64，可以忽略
+        幽灵链表本身不加锁，由所属缓存在锁内调用
+    */
+    template <typename KEY>
+    class myGhostList
+    {
+    public:
+        static constexpr size_t kMinRingSize = 16;
+
+        /*
+            构造函数
+        */
+        explicit myGhostList(size_t capacity)
+            : capacity_(capacity), weight_(0), head_(0), tail_(0), ring_(kMinRingSize)
+        {
+        }
+
+        myGhostList(const myGhostList &) = delete;
+        myGhostList &operator=(const myGhostList &) = delete;
+
+        /*
+            成员函数接口
+        */
+        // 记录一个被淘汰的key，超出容量时丢弃最早的记录；权重超过整个容量的key不记录
+        template <typename K>
+        void push(const K &key, size_t weight)
+        {
+            if (weight > capacity_)
+            {
+                return;
+            }
+            uint64_t fingerprint = fingerprintOf(key);
+            auto it = index_.find(fingerprint);
+            if (it != index_.end())
+            {
+                weight_ -= ring_[it->second & (ring_.size() - 1)].weight_;
+                index_.erase(it);
+            }
+            while (weight_ + weight > capacity_)
+            {
+                popFront();
+            }
+            if (tail_ - head_ == ring_.size())
+            {
+                // 失效条目过半时原地整理，否则扩容
+                rebuild(index_.size() * 2 <= ring_.size() ? ring_.size() : ring_.size() * 2);
+            }
+            ring_[tail_ & (ring_.size() - 1)] = Entry{fingerprint, weight};
+            index_.insert_or_assign(fingerprint, tail_);
+            ++tail_;
+            weight_ += weight;
+        }
+
+        // 命中则删除记录，并通过 weight 返回记录的权重
+        template <typename K>
+        bool take(const K &key, size_t &weight)
+        {
+            auto it = index_.find(fingerprintOf(key));
+            if (it == index_.end())
+            {
+                return false;
+            }
+            weight = ring_[it->second & (ring_.size() - 1)].weight_;
+            weight_ -= weight;
+            index_.erase(it);
+            return true;
+        }
+
+        template <typename K>
+        bool contains(const K &key) const
+        {
+            return index_.contains(fingerprintOf(key));
+        }
+
+        // 调整容量，超出的最早记录被丢弃
+        void setCapacity(size_t capacity)
+        {
+            capacity_ = capacity;
+            while (weight_ > capacity_)
+            {
+                popFront();
+            }
+        }
+
+        // 丢弃最早的一条有效记录，途中跳过失效条目(供所属缓存按自己的约束裁剪)
+        void popFront()
+        {
+            while (head_ != tail_)
+            {
+                uint64_t seq = head_++;
+                const Entry &entry = ring_[seq & (ring_.size() - 1)];
+                auto it = index_.find(entry.fingerprint_);
+                if (it != index_.end() && it->second == seq)
+                {
+                    weight_ -= entry.weight_;
+                    index_.erase(it);
+                    return;
+                }
+            }
+        }
+
+        void clear()
+        {
+            index_.clear();
+            head_ = tail_ = 0;
+            weight_ = 0;
+        }
+
+        // 记录数
+        size_t size() const { return index_.size(); }
+
+        // 记录的总权重
+        size_t weight() const { return weight_; }
+
+        size_t capacity() const { return capacity_; }
+
+    private:
+        struct Entry
+        {
+            uint64_t fingerprint_; // key的指纹
+            uint64_t weight_;      // 淘汰时的权重
+        };
+
+        template <typename K>
+        static uint64_t fingerprintOf(const K &key)
+        {
+            myKeyHash<KEY> hashFunc;
+            return myHashMix(hashFunc(key));
+        }
+
+        // 按原有顺序把有效记录搬到大小为 size 的新环形数组
+        void rebuild(size_t size)
+        {
+            std::vector<Entry> ring(size);
+            uint64_t next = 0;
+            for (uint64_t seq = head_; seq != tail_; ++seq)
+            {
+                const Entry &entry = ring_[seq & (ring_.size() - 1)];
+                auto it = index_.find(entry.fingerprint_);
+                if (it != index_.end() && it->second == seq)
+                {
+                    ring[next] = entry;
+                    it->second = next++;
+                }
+            }
+            ring_.swap(ring);
+            head_ = 0;
+            tail_ = next;
+        }
+
+        size_t capacity_;                           // 容量(权重单位)
+        size_t weight_;                             // 有效记录的总权重
+        uint64_t head_;                             // 最早条目的序号
+        uint64_t tail_;                             // 下一个条目的序号
+        std::vector<Entry> ring_;                   // 环形数组(大小为2的幂)，序号对大小取模即下标
+        myFlatHashMap<uint64_t, uint64_t> index_;   // 指纹——序号
+    };
+} // namespace myCacheSystem
+
+#endif // MYGHOSTLIST_H
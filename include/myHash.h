@@ -0,0 +1,70 @@
+#ifndef MYHASH_H
+#define MYHASH_H
+
+#include <functional>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace myCacheSystem
+{
+    /*
+        缓存键的哈希函数
+        默认与 std::hash 相同；对 std::string 键开启透明查找(is_transparent)，
+        可以直接用 std::string_view / const char* 查询，不必构造临时 std::string
+    */
+    template <typename KEY>
+    struct myKeyHash : std::hash<KEY>
+    {
+    };
+
+    template <>
+    struct myKeyHash<std::string>
+    {
+        using is_transparent = void;
+
+        size_t operator()(std::string_view key) const noexcept
+        {
+            // 与 std::hash<std::string> 结果一致
+            return std::hash<std::string_view>{}(key);
+        }
+    };
+
+    // 透明比较
+    using myKeyEqual = std::equal_to<>;
+
+    /*
+        64位哈希混淆(murmur3 fmix64)
+        std::hash 对整数是恒等映射，连续的ID直接取模会集中在少数分片上，混淆后每一位都依赖输入的所有位
+    */
+    inline uint64_t myHashMix(uint64_t hash) noexcept
+    {
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 33;
+        hash *= 0xc4ceb9fe1a85ec53ULL;
+        hash ^= hash >> 33;
+        return hash;
+    }
+
+    /*
+        判断 LOOKUP 能否作为 KEY 的透明查找键(KEY 本身不算)
+    */
+    template <typename KEY, typename LOOKUP, typename = void>
+    struct myIsTransparentKey : std::false_type
+    {
+    };
+
+    template <typename KEY, typename LOOKUP>
+    struct myIsTransparentKey<KEY, LOOKUP, std::void_t<typename myKeyHash<KEY>::is_transparent>>
+        : std::bool_constant<!std::is_same_v<std::decay_t<LOOKUP>, KEY> &&
+                             std::is_invocable_v<myKeyHash<KEY>, const LOOKUP &>>
+    {
+    };
+
+    template <typename KEY, typename LOOKUP>
+    inline constexpr bool myIsTransparentKey_v = myIsTransparentKey<KEY, LOOKUP>::value;
+} // namespace myCacheSystem
+
+#endif // MYHASH_H
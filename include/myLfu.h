@@ -1,12 +1,23 @@
 #ifndef MYLFU_HPP
 #define MYLFU_HPP
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <vector>
-#include <unordered_map>
 #include <thread>
+#include "myCachePolicy.h"
+#include "myNodePool.h"
+#include "myHash.h"
+#include "myFlatHashMap.h"
+#include "myReadBuffer.h"
+#include "myTimingWheel.h"
+#include "myShardedCache.h"
+#include "myValueHandle.h"
+#include "myRefreshAhead.h"
 
 namespace myCacheSystem
 {
@@ -17,8 +28,16 @@ namespace myCacheSystem
     template <typename KEY, typename VALUE>
     class myLfuCache;
 
+    // 频次老化方式：平均访问频次超过上限时，所有结点的访问频次统一衰减
+    enum class myLfuDecay
+    {
+        Subtract, // 减去 maxAverageNum / 2
+        Halve     // 减半
+    };
+
+    // LFU的缓存节点，继承时间轮钩子以支持过期时间
     template <typename KEY, typename VALUE>
-    class myLfuNode
+    class myLfuNode : public myTimerNode
     {
         friend class myLfuCache<KEY, VALUE>;
         friend class FreqList<KEY, VALUE>;
@@ -28,9 +47,9 @@ namespace myCacheSystem
             构造函数
         */
         // 默认构造
-        myLfuNode() : accessSize_(1), next_(nullptr) {};
+        myLfuNode() : weight_(1), generation_(0), pinned_(false), freqList_(nullptr), next_(nullptr), prev_(nullptr) {};
         // 有参构造
-        myLfuNode(KEY key, VALUE value) : key_(key), value_(value), accessSize_(1), next_(nullptr) {}
+        myLfuNode(KEY key, VALUE value) : weight_(1), generation_(0), pinned_(false), key_(key), value_(value), freqList_(nullptr), next_(nullptr), prev_(nullptr) {}
 
         /*
             成员函数接口
@@ -50,112 +69,185 @@ namespace myCacheSystem
             value_ = value;
         }
 
-        void addAccessSize()
+        // 访问次数即所在频次桶最近一次规整后的频次，不在缓存中时为0
+        size_t getAccessSize() const
         {
-            accessSize_++;
+            return freqList_ ? freqList_->getFreq() : 0;
         }
 
-        size_t getAccessSize()
+        size_t getWeight() const
         {
-            return accessSize_;
+            return weight_;
         }
 
-        void setAccessSize(size_t accessSize)
+        // 释放键值，结点归还 myNodePool 时调用，空闲栈中的结点不再占用键值的内存
+        void releasePayload()
         {
-            if (accessSize < 1)
-            {
-                accessSize_ = 1;
-                return;
-            }
-            accessSize_ = accessSize;
+            key_ = KEY();
+            value_ = VALUE();
         }
 
     private:
-        size_t accessSize_; // 访问次数
+        size_t weight_;       // 权重，由缓存的权重函数计算
+        uint32_t generation_; // 结点代数，每次从结点池复用时加一，用于校验读缓冲区中的记录
+        std::atomic<bool> pinned_; // 是否交出过句柄(getHandle)，读锁下并发设置；为true时不能原地修改或立即复用
         KEY key_;
         VALUE value_;
-        std::shared_ptr<myLfuNode<KEY, VALUE>> next_;
-        std::weak_ptr<myLfuNode<KEY, VALUE>> prev_;
+        FreqList<KEY, VALUE> *freqList_; // 所在的频次桶，访问次数由桶统一记录
+        myLfuNode<KEY, VALUE> *next_;    // 结点由myNodePool统一管理，使用裸指针侵入式链接
+        myLfuNode<KEY, VALUE> *prev_;
     };
 
     /*
-        频率链表，访问频次key对应的相同频次的结点
+        频次桶：访问频次相同的结点组成的链表，同频次按加入顺序排列(首结点最先加入)
+        所有非空的频次桶按频次升序串成双向链表，头部即最小频次桶，
+        结点提升时只需移动到相邻的桶，桶变空后立即归还给桶池
     */
     template <typename KEY, typename VALUE>
     class FreqList
     {
+        friend class myLfuCache<KEY, VALUE>;
+
     public:
-        typedef std::shared_ptr<myLfuNode<KEY, VALUE>> NodePtr;
+        typedef myLfuNode<KEY, VALUE> *NodePtr;
         /*
             构造函数
         */
+        // 默认构造(供桶池预分配)
+        FreqList() : freq_(0), epoch_(0), size_(0), head_(nullptr), tail_(nullptr), prevList_(nullptr), nextList_(nullptr) {}
         // 显式构造函数，避免变成转换构造函数
-        explicit FreqList(size_t freq) : freq_(freq)
-        {
-            initNodeList();
-        }
+        explicit FreqList(size_t freq) : freq_(freq), epoch_(0), size_(0), head_(nullptr), tail_(nullptr), prevList_(nullptr), nextList_(nullptr) {}
+
+        // 结点和相邻桶都以裸指针链接，桶不可拷贝
+        FreqList(const FreqList &) = delete;
+        FreqList &operator=(const FreqList &) = delete;
 
         /*
             成员函数方法
         */
-        // 增加结点
-        void addLfuNode(NodePtr node)
-        {
-            if (!node)
-                return;
-
-            auto prev = tail_->prev_.lock(); // 获取最后一个结点
-            prev->next_ = node;
-            node->next_ = tail_;
-            tail_->prev_ = node;
-            node->prev_ = prev;
-        }
+        // 增加结点(尾部)
+        void addLfuNode(NodePtr node);
 
         // 移除结点
-        void removeLfuNode(NodePtr node)
-        {
-            if (!node || !head_ || !tail_)
-                return;
+        void removeLfuNode(NodePtr node);
 
-            if (node->prev_.expired() || !node->next_)
-                return;
-
-            auto prev = node->prev_.lock();
-            prev->next_ = node->next_;
-            node->next_->prev_ = prev;
-            node->next_ = nullptr;
-        }
+        // 把所有结点按原有顺序移动到 other 的尾部(front 为真时移动到首部)
+        void moveAllTo(FreqList &other, bool front = false);
 
         // 判断是否为空
         bool isEmpty() const
         {
-            return head_->next_ == tail_;
+            return head_ == nullptr;
         }
 
         // 获取首部结点(同频次优先删除最先添加的，即首结点)
         NodePtr getFirstNode() const
         {
-            return head_->next_;
+            return head_;
         }
 
-    private:
-        /*
-            私有成员函数方法
-        */
-        void initNodeList();
+        size_t getFreq() const
+        {
+            return freq_;
+        }
+
+        // 桶中的结点数
+        size_t size() const
+        {
+            return size_;
+        }
 
-        size_t freq_;  // 访问次数
-        NodePtr head_; // 虚拟头节点
-        NodePtr tail_; // 虚拟尾结点
+    private:
+        size_t freq_;                      // 访问次数
+        size_t epoch_;                     // 频次最近一次规整时的老化纪元
+        size_t size_;                      // 结点数
+        NodePtr head_;                     // 首结点
+        NodePtr tail_;                     // 尾结点
+        FreqList<KEY, VALUE> *prevList_;   // 频次更小的相邻桶
+        FreqList<KEY, VALUE> *nextList_;   // 频次更大的相邻桶
     };
 
     template <typename KEY, typename VALUE>
-    void FreqList<KEY, VALUE>::initNodeList()
+    void FreqList<KEY, VALUE>::addLfuNode(NodePtr node)
     {
-        head_ = std::make_shared<myLfuNode<KEY, VALUE>>();
-        tail_ = std::make_shared<myLfuNode<KEY, VALUE>>();
-        head_->next_ = tail_;
-        tail_->prev_ = head_;
+        if (!node)
+            return;
+
+        node->prev_ = tail_;
+        node->next_ = nullptr;
+        if (tail_)
+        {
+            tail_->next_ = node;
+        }
+        else
+        {
+            head_ = node;
+        }
+        tail_ = node;
+        node->freqList_ = this;
+        ++size_;
+    }
+
+    template <typename KEY, typename VALUE>
+    void FreqList<KEY, VALUE>::removeLfuNode(NodePtr node)
+    {
+        if (!node || node->freqList_ != this)
+            return;
+
+        if (node->prev_)
+        {
+            node->prev_->next_ = node->next_;
+        }
+        else
+        {
+            head_ = node->next_;
+        }
+        if (node->next_)
+        {
+            node->next_->prev_ = node->prev_;
+        }
+        else
+        {
+            tail_ = node->prev_;
+        }
+        node->prev_ = nullptr;
+        node->next_ = nullptr;
+        node->freqList_ = nullptr;
+        --size_;
+    }
+
+    template <typename KEY, typename VALUE>
+    void FreqList<KEY, VALUE>::moveAllTo(FreqList &other, bool front)
+    {
+        if (isEmpty())
+            return;
+
+        // 整段拼接到 other 首部或尾部，只需要逐个修改结点所在的桶
+        for (NodePtr node = head_; node; node = node->next_)
+        {
+            node->freqList_ = &other;
+        }
+        if (other.isEmpty())
+        {
+            other.head_ = head_;
+            other.tail_ = tail_;
+        }
+        else if (front)
+        {
+            tail_->next_ = other.head_;
+            other.head_->prev_ = tail_;
+            other.head_ = head_;
+        }
+        else
+        {
+            head_->prev_ = other.tail_;
+            other.tail_->next_ = head_;
+            other.tail_ = tail_;
+        }
+        other.size_ += size_;
+        head_ = nullptr;
+        tail_ = nullptr;
+        size_ = 0;
     }
 
     /*
@@ -166,14 +258,38 @@ namespace myCacheSystem
     {
     public:
         typedef myLfuNode<KEY, VALUE> LfuNodeType;
-        typedef std::shared_ptr<LfuNodeType> NodePrt;
-        typedef std::unordered_map<KEY, NodePrt> NodeMap;
+        typedef LfuNodeType *NodePrt;
+        typedef myFlatHashMap<KEY, NodePrt> NodeMap;
+        typedef myNodePool<LfuNodeType> NodePool;
+        typedef FreqList<KEY, VALUE> FreqListType;
+        typedef FreqListType *FreqListPtr;
+        typedef myNodePool<FreqListType> FreqListPool;
+        typedef myReadBuffer<LfuNodeType> ReadBuffer;
+        typedef myWeigher<KEY, VALUE> Weigher;
+        typedef myTimingWheel<LfuNodeType> TimingWheel;
+        typedef myPinnedNodes<LfuNodeType> PinnedNodes;
+        typedef myRefreshAhead<KEY, VALUE> RefreshAhead;
+
+        static constexpr size_t kExpireBudget = 16; // 每次写操作最多回收的过期结点数
 
         /*
             构造函数
         */
-        myLfuCache(size_t capacity, size_t maxAverageNum = 1000000)
-            : capacity_(capacity), minFreq_(INT8_MAX), maxAverageNum_(maxAverageNum), curAverageNum_(0), curTotalNum_(0) {}
+        // bufferedReads: 命中只在读锁下记录到读缓冲区，由持有写锁的线程批量更新访问频次
+        // weigher: 非空时 capacity 为权重预算(如字节数)，结点池按需扩容
+        // decay: 平均访问频次超过 maxAverageNum 时的频次衰减方式
+        myLfuCache(size_t capacity, size_t maxAverageNum = 1000000, bool bufferedReads = false, Weigher weigher = Weigher(), myLfuDecay decay = myLfuDecay::Subtract)
+            : capacity_(capacity), totalWeight_(0), maxAverageNum_(maxAverageNum), curAverageNum_(0), curTotalNum_(0), decay_(decay), agingEpoch_(0), weigher_(std::move(weigher)), pool_(weigher_ ? 0 : capacity), freqPool_(0), freqHead_(nullptr)
+        {
+            if (!weigher_)
+            {
+                LfuMap_.reserve(capacity_);
+            }
+            if (bufferedReads)
+            {
+                readBuffer_ = std::make_unique<ReadBuffer>();
+            }
+        }
 
         ~myLfuCache() override = default;
 
@@ -181,153 +297,562 @@ namespace myCacheSystem
             成员函数接口
         */
         // 添加缓存
-        virtual void put(KEY key, VALUE value) override
+        virtual void put(const KEY &key, const VALUE &value) override
+        {
+            putImpl(key, value);
+        }
+
+        virtual void put(KEY &&key, VALUE &&value) override
+        {
+            putImpl(std::move(key), std::move(value));
+        }
+
+        // 添加带过期时间的缓存
+        virtual void put(const KEY &key, const VALUE &value, std::chrono::milliseconds ttl) override
+        {
+            putImpl(key, value, myTimingWheelDeadline(ttl));
+        }
+
+        virtual void put(KEY &&key, VALUE &&value, std::chrono::milliseconds ttl) override
+        {
+            putImpl(std::move(key), std::move(value), myTimingWheelDeadline(ttl));
+        }
+
+        // 获取value
+        virtual bool get(const KEY &key, VALUE &value) override
+        {
+            return getImpl(key, value);
+        }
+
+        // 访问缓存数据函数
+        virtual VALUE get(const KEY &key) override
+        {
+            VALUE value{};
+            getImpl(key, value);
+            return value;
+        }
+
+        // 透明查找：std::string 键可以直接用 std::string_view 查询
+        template <typename K, typename = std::enable_if_t<myIsTransparentKey_v<KEY, K>>>
+        bool get(const K &key, VALUE &value)
+        {
+            return getImpl(key, value);
+        }
+
+        template <typename K, typename = std::enable_if_t<myIsTransparentKey_v<KEY, K>>>
+        VALUE get(const K &key)
+        {
+            VALUE value{};
+            getImpl(key, value);
+            return value;
+        }
+
+        // 非阻塞接口
+        virtual myTryStatus tryGet(const KEY &key, VALUE &value) override
+        {
+            return lookup<true>(key, [&](NodePrt node)
+                                { value = node->value_; });
+        }
+
+        virtual bool tryPut(const KEY &key, const VALUE &value) override
+        {
+            return putImpl<true>(key, value);
+        }
+
+        virtual bool tryPut(const KEY &key, const VALUE &value, std::chrono::milliseconds ttl) override
+        {
+            return putImpl<true>(key, value, myTimingWheelDeadline(ttl));
+        }
+
+        // 零拷贝读取：返回指向缓存中value的句柄，命中的处理与 get 相同，见 myValueHandle
+        template <typename K>
+        myValueHandle<VALUE> getHandle(const K &key)
+        {
+            auto guard = pinnedNodes_.pin();
+            const VALUE *value = nullptr;
+            lookup(key, [&](NodePrt node)
+                   {
+                node->pinned_.store(true, std::memory_order_relaxed);
+                value = &node->value_; });
+            return value ? myValueHandle<VALUE>(std::move(guard), value) : myValueHandle<VALUE>();
+        }
+
+        // 批量查询：整批只加一次锁
+        virtual size_t getMany(std::span<const KEY> keys, std::span<VALUE> values, std::vector<bool> &hits) override
+        {
+            hits.assign(keys.size(), false);
+            return getManyImpl(keys.size(), [](size_t i)
+                               { return i; }, keys, values, hits);
+        }
+
+        // 只查询 indexes 指定的位置，结果写入 values/hits 的相同位置(供分片缓存按分片分组后调用)
+        size_t getMany(std::span<const KEY> keys, std::span<const size_t> indexes, std::span<VALUE> values, std::vector<bool> &hits)
+        {
+            return getManyImpl(indexes.size(), [&](size_t i)
+                               { return indexes[i]; }, keys, values, hits);
+        }
+
+        // 批量添加：整批只加一次锁
+        virtual void putMany(std::span<const KEY> keys, std::span<const VALUE> values) override
+        {
+            putManyImpl(keys.size(), [](size_t i)
+                        { return i; }, keys, values);
+        }
+
+        void putMany(std::span<const KEY> keys, std::span<const size_t> indexes, std::span<const VALUE> values)
+        {
+            putManyImpl(indexes.size(), [&](size_t i)
+                        { return indexes[i]; }, keys, values);
+        }
+
+        // 清空缓存，回收资源
+        void clear()
+        {
+            std::lock_guard<std::shared_mutex> lock(mutex_);
+            drainReadBuffer();
+            // 结点归还给结点池
+            for (auto &pair : LfuMap_)
+            {
+                pair.second->freqList_ = nullptr;
+                releaseNode(pair.second);
+            }
+            LfuMap_.clear();
+            // 频次桶归还给桶池
+            while (freqHead_)
+            {
+                FreqListPtr next = freqHead_->nextList_;
+                freqHead_->head_ = freqHead_->tail_ = nullptr;
+                freqHead_->size_ = 0;
+                freqHead_->nextList_ = nullptr;
+                freqPool_.deallocate(freqHead_);
+                freqHead_ = next;
+            }
+            wheel_.clear();
+            totalWeight_ = 0;
+            curTotalNum_ = 0;
+            curAverageNum_ = 0;
+        }
+
+        // 当前缓存的总权重(未设置权重函数时即缓存项数量)
+        size_t weight() const
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            return totalWeight_;
+        }
+
+        // 开启写入后刷新：写入 refreshAfter 之后的命中返回旧值，并在 executor 上用 loader 重新加载一次，见 myRefreshAhead
+        void enableRefresh(std::chrono::milliseconds refreshAfter, typename RefreshAhead::Loader loader, myExecutor &executor = myExecutor::defaultExecutor(),
+                           std::shared_ptr<myRefreshBudget> budget = nullptr)
+        {
+            std::lock_guard<std::shared_mutex> lock(mutex_);
+            refresh_.enable(refreshAfter, std::move(loader), [this](const KEY &key, VALUE &&value, uint64_t expireTick)
+                            { refreshIfPending(key, std::move(value), expireTick); }, executor, std::move(budget));
+        }
+
+    private:
+        /*
+            私有函数方法
+        */
+        // 键值以转发引用传入，右值直接移动进结点；expireTick: 过期刻度，0表示不过期
+        // TRY 为 true 时写锁被占用直接返回false
+        template <bool TRY = false, typename K, typename V>
+        bool putImpl(K &&key, V &&value, uint64_t expireTick = 0)
         {
             // 1. 检查capacity是否足够
             if (capacity_ <= 0)
-                return;
+                return true;
 
-            // 2. 查看是否已经在缓存中，如果已经在，则更新value已经访问次数
-            std::lock_guard<std::mutex> lock(mutex_); // 加互斥锁
+            // 2. 加互斥锁，顺带回放读缓冲区、回收过期结点
+            std::unique_lock<std::shared_mutex> lock(mutex_, std::defer_lock);
+            if (!myAcquireLock<TRY>(lock))
+            {
+                return false;
+            }
+            drainReadBuffer();
+            expireEntries();
+            putLocked(std::forward<K>(key), std::forward<V>(value), expireTick);
+            return true;
+        }
+
+        // 查看是否已经在缓存中，如果已经在，则更新value以及访问次数(调用者持有写锁)
+        template <typename K, typename V>
+        void putLocked(K &&key, V &&value, uint64_t expireTick = 0)
+        {
             auto it = LfuMap_.find(key);
             if (it != LfuMap_.end())
             {
-                it->second->setValue(value); // 重置值
+                NodePrt node = it->second;
+                // 交出过句柄的结点不能原地修改，先换成新结点
+                if (node->pinned_.load(std::memory_order_relaxed))
+                {
+                    node = replacePinnedNode(node);
+                }
+                node->value_ = std::forward<V>(value); // 重置值
+                // 新值超过整个预算时直接移出缓存
+                size_t weight = weigh(node->key_, node->value_);
+                if (weight > capacity_)
+                {
+                    eraseNode(node);
+                    return;
+                }
+                totalWeight_ = totalWeight_ - node->weight_ + weight;
+                node->weight_ = weight;
+                setExpiry(node, expireTick);
                 // 访问次数加一，同时需要移动结点到相应的FreqList中
-                getInternal(it->second, value);
+                getInternal(node);
+                // 权重变大后可能超出预算
+                while (totalWeight_ > capacity_)
+                {
+                    removeForLfu();
+                }
                 return;
             }
 
             // 3. 如果不在则添加至缓存池
-            putInternal(key, value);
+            putInternal(std::forward<K>(key), std::forward<V>(value), expireTick);
         }
 
-        // 获取value
-        virtual bool get(KEY key, VALUE &value) override
+        template <typename K>
+        bool getImpl(const K &key, VALUE &value)
+        {
+            return lookup(key, [&](NodePrt node)
+                          { value = node->value_; }) == myTryStatus::Hit;
+        }
+
+        // 查找key并更新访问频次，命中时在锁内调用 visit(node)；TRY 为 true 时锁被占用直接返回 Busy
+        template <bool TRY = false, typename K, typename VISIT>
+        myTryStatus lookup(const K &key, VISIT &&visit)
+        {
+            // 读缓冲模式：读锁下记录命中，缓冲区满时尝试获取写锁批量回放
+            if (readBuffer_)
+            {
+                bool shouldDrain = false;
+                {
+                    std::shared_lock<std::shared_mutex> lock(mutex_, std::defer_lock);
+                    if (!myAcquireLock<TRY>(lock))
+                    {
+                        return myTryStatus::Busy;
+                    }
+                    auto it = LfuMap_.find(key);
+                    if (it == LfuMap_.end() || isExpired(it->second))
+                    {
+                        return myTryStatus::Miss;
+                    }
+                    NodePrt node = it->second;
+                    refresh_.onHit(node);
+                    visit(node);
+                    shouldDrain = readBuffer_->record(node, node->generation_);
+                }
+                if (shouldDrain)
+                {
+                    std::unique_lock<std::shared_mutex> lock(mutex_, std::try_to_lock);
+                    if (lock.owns_lock())
+                    {
+                        drainReadBuffer();
+                        expireEntries();
+                    }
+                }
+                return myTryStatus::Hit;
+            }
+
+            std::unique_lock<std::shared_mutex> lock(mutex_, std::defer_lock);
+            if (!myAcquireLock<TRY>(lock))
+            {
+                return myTryStatus::Busy;
+            }
+            expireEntries();
+            return visitLocked(key, visit) ? myTryStatus::Hit : myTryStatus::Miss;
+        }
+
+        // 命中时拷贝value并增加访问频次(调用者持有写锁)
+        template <typename K>
+        bool getLocked(const K &key, VALUE &value)
+        {
+            return visitLocked(key, [&](NodePrt node)
+                               { value = node->value_; });
+        }
+
+        // 命中时调用 visit(node) 并增加访问频次(调用者持有写锁)
+        template <typename K, typename VISIT>
+        bool visitLocked(const K &key, VISIT &&visit)
         {
-            std::lock_guard<std::mutex> lock(mutex_);
             auto it = LfuMap_.find(key); // 获取节点
-            if (it != LfuMap_.end())
+            if (it != LfuMap_.end() && !isExpired(it->second))
             {
-                getInternal(it->second, value);
+                refresh_.onHit(it->second);
+                visit(it->second);
+                getInternal(it->second);
                 return true;
             }
 
             return false;
         }
 
-        // 访问缓存数据函数
-        virtual VALUE get(KEY key) override
+        // 批量查询，indexAt(i) 给出第i个要查询的下标；读缓冲模式下也直接更新频次
+        template <typename INDEX>
+        size_t getManyImpl(size_t count, INDEX &&indexAt, std::span<const KEY> keys, std::span<VALUE> values, std::vector<bool> &hits)
         {
-            VALUE value{};
-            get(key, value);
-            return value;
+            std::lock_guard<std::shared_mutex> lock(mutex_);
+            drainReadBuffer();
+            expireEntries();
+            size_t hitCount = 0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                size_t index = indexAt(i);
+                if (getLocked(keys[index], values[index]))
+                {
+                    hits[index] = true;
+                    ++hitCount;
+                }
+            }
+            return hitCount;
         }
 
-        // 清空缓存，回收资源
-        void clear()
+        // 批量添加
+        template <typename INDEX>
+        void putManyImpl(size_t count, INDEX &&indexAt, std::span<const KEY> keys, std::span<const VALUE> values)
         {
-            std::lock_guard<std::mutex> lock(mutex_);
-            LfuMap_.clear();
-            keyToFreqList_.clear();
+            if (capacity_ <= 0)
+                return;
+
+            std::lock_guard<std::shared_mutex> lock(mutex_);
+            drainReadBuffer();
+            expireEntries();
+            for (size_t i = 0; i < count; ++i)
+            {
+                size_t index = indexAt(i);
+                putLocked(keys[index], values[index]);
+            }
         }
 
-    private:
-        /*
-            私有函数方法
-        */
-        // 获取缓存
-        void getInternal(NodePrt node, VALUE &value);
+        // 写回后台刷新的结果：结点仍处于已认领状态(刷新期间没有被重新写入、移出或过期)时才更新
+        void refreshIfPending(const KEY &key, VALUE &&value, uint64_t expireTick)
+        {
+            std::lock_guard<std::shared_mutex> lock(mutex_);
+            drainReadBuffer();
+            expireEntries();
+            auto it = LfuMap_.find(key);
+            if (it == LfuMap_.end() || isExpired(it->second) || it->second->getRefreshTick() != 0)
+            {
+                return;
+            }
+            putLocked(key, std::move(value), expireTick);
+        }
+
+        // 结点是否已经过期(读锁下即可判断，过期结点由写操作回收)
+        bool isExpired(NodePrt node) const
+        {
+            return node->hasExpiry() && node->isExpired(myTimingWheelNow());
+        }
+
+        // 推进时间轮，回收最多 kExpireBudget 个过期结点(调用者持有写锁)
+        void expireEntries()
+        {
+            if (wheel_.empty())
+            {
+                return;
+            }
+            wheel_.expire(myTimingWheelNow(), kExpireBudget, [this](NodePrt node)
+                          { eraseNode(node); });
+        }
+
+        // 设置结点的过期刻度(0表示不过期)，开启刷新时同时记录刷新刻度
+        void setExpiry(NodePrt node, uint64_t expireTick)
+        {
+            node->setRefreshTick(refresh_.deadline());
+            if (expireTick != 0)
+            {
+                wheel_.schedule(node, expireTick);
+            }
+            else
+            {
+                wheel_.cancel(node);
+            }
+        }
+
+        // 回放读缓冲区中记录的命中(调用者持有写锁)
+        void drainReadBuffer()
+        {
+            if (!readBuffer_)
+            {
+                return;
+            }
+            readBuffer_->drain([this](NodePrt node, uint32_t generation)
+                               {
+                // 结点已被淘汰或复用给其他key，丢弃这条记录
+                if (node->generation_ != generation || !node->freqList_)
+                {
+                    return;
+                }
+                getInternal(node); });
+        }
+
+        // 计算缓存项权重
+        template <typename K, typename V>
+        size_t weigh(const K &key, const V &value) const
+        {
+            return weigher_ ? weigher_(key, value) : 1;
+        }
+
+        // 更新结点访问频次
+        void getInternal(NodePrt node);
 
         // 添加缓存
-        void putInternal(KEY key, const VALUE &value);
+        template <typename K, typename V>
+        void putInternal(K &&key, V &&value, uint64_t expireTick);
 
-        // 从对应freq的链表移除
+        // 从频次链表、哈希表和时间轮中删除结点并归还结点池
+        void eraseNode(NodePrt node);
+
+        // 归还结点池；交出过句柄的结点等待所有句柄释放后再归还
+        void releaseNode(NodePrt node)
+        {
+            if (node->pinned_.load(std::memory_order_relaxed))
+            {
+                pinnedNodes_.retire(node);
+                return;
+            }
+            pool_.deallocate(node);
+        }
+
+        // 从结点池取出结点，先回收已经没有句柄引用的结点
+        NodePrt allocateNode()
+        {
+            pinnedNodes_.reclaim([this](NodePrt node)
+                                 {
+                node->pinned_.store(false, std::memory_order_relaxed);
+                pool_.deallocate(node); });
+            return pool_.allocate();
+        }
+
+        // 用新结点顶替交出过句柄的结点(频次桶位置、哈希表和过期时间不变)，旧结点等待延迟回收
+        NodePrt replacePinnedNode(NodePrt old);
+
+        // 从所在的频次桶移除，桶变空则回收
         void removeFromFreqList(NodePrt node);
 
-        // 增加到对应freq的链表
+        // 新结点加入频次为1的桶
         void addToFreqList(NodePrt node);
 
+        // 在 prev 之后插入一个频次为 freq 的新桶(prev 为空时插入到头部)
+        FreqListPtr insertFreqList(FreqListPtr prev, size_t freq);
+
+        // 从桶链表摘下空桶并归还桶池
+        void releaseFreqList(FreqListPtr list);
+
         // 增加当前平均访问频次和访问总次数
         void addAccessFreq();
 
-        // 执行算法减少当前所有结点的访问次数
+        // 执行算法减少当前所有结点的访问次数(只推进老化纪元，结点频次延迟到访问时规整)
         void handleOverMaxAverageNum();
 
+        // 把频次经过 epochs 个老化纪元的衰减
+        size_t decayFreq(size_t freq, size_t epochs) const;
+
+        // 把频次桶的频次规整到当前纪元，与频次相同的已规整相邻桶合并，返回合并后的桶
+        FreqListPtr normalizeFreqList(FreqListPtr list);
+
+        // 合并两个频次相同的相邻桶(low 在前)，返回保留的桶
+        FreqListPtr mergeFreqList(FreqListPtr low, FreqListPtr high);
+
         // 关键算法，删除最少使用节点
         void removeForLfu();
 
         // 删除节点后减少当前平均访问频次和访问总次数
         void decreaseFreqNum(size_t freq);
 
-        // 更新最小频率
-        void updateMinFreq();
-
-        size_t capacity_;                                                                 // 容量大小
-        size_t minFreq_;                                                                  // 最小访问频次(用于找到最小访问频次结点)
+        size_t capacity_;                                                                 // 容量大小(设置权重函数时为权重预算)
+        size_t totalWeight_;                                                              // 当前总权重
         size_t maxAverageNum_;                                                            // 最大平均访问频次(当平均访问次数大于此值，则全部结点的访问频次按照一定的算法同时缩减)
         size_t curAverageNum_;                                                            // 当前平均访问频次
-        size_t curTotalNum_;                                                              // 当前访问所有缓存次数总数
-        std::mutex mutex_;                                                                // 互斥锁
+        size_t curTotalNum_;                                                              // 当前访问所有缓存次数总数(老化后为估计值)
+        myLfuDecay decay_;                                                                // 频次衰减方式
+        size_t agingEpoch_;                                                               // 老化纪元，每次老化加一
+        mutable std::shared_mutex mutex_;                                                 // 读写锁，读缓冲模式下命中只需要读锁
+        std::unique_ptr<ReadBuffer> readBuffer_;                                          // 读缓冲区，仅读缓冲模式创建
+        Weigher weigher_;                                                                 // 权重函数，为空时每个结点权重为1
+        NodePool pool_;                                                                   // 结点池
         NodeMap LfuMap_;                                                                  // key——结点映射
-        std::unordered_map<size_t, std::unique_ptr<FreqList<KEY, VALUE>>> keyToFreqList_; //  访问频次-链表
+        TimingWheel wheel_;                                                               // 时间轮，管理设置了过期时间的结点
+        FreqListPool freqPool_;                                                           // 频次桶池
+        FreqListPtr freqHead_;                                                            // 频次桶链表头部，即最小访问频次的桶
+        PinnedNodes pinnedNodes_;                                                         // 交出过句柄、等待延迟回收的结点
+        RefreshAhead refresh_;                                                            // 写入后刷新，最先析构，等待进行中的刷新结束
     };
 
     template <typename KEY, typename VALUE>
-    void myLfuCache<KEY, VALUE>::getInternal(NodePrt node, VALUE &value)
+    void myLfuCache<KEY, VALUE>::getInternal(NodePrt node)
     {
         /*
-            把该节点从当前频次链表中删除，并且移向频次+1的链表中
+            把该节点从当前频次桶移动到频次+1的相邻桶，相邻桶不存在则在当前桶之后新建，
+            当前桶变空则回收，整个过程不需要查找也不需要重新计算最小频次
+            移动前先把当前桶和后继桶规整到当前纪元，规整后频次相同的桶会被合并
         */
-        value = node->getValue();
-        // 从原有链表删除
-        removeFromFreqList(node);
-        // 访问频次+1
-        node->addAccessSize();
-        // 添加到对应访问次数的链表
-        addToFreqList(node);
-        /*
-            结点移动之后，要注意如果当前node的访问频次如果等于minFreq+1，并且其前驱链表为空，
-            则说明keyToFreqList_[node->freq - 1]链表因node的迁移已经空了，需要更新最小访问频次,
-            同时当前平均访问频次和当前访问所有缓存次数总数都需要更新
-        */
-        if (node->getAccessSize() - 1 == minFreq_ && keyToFreqList_[node->getAccessSize() - 1]->isEmpty())
+        FreqListPtr cur = normalizeFreqList(node->freqList_);
+        FreqListPtr next = cur->nextList_;
+        while (next && next->epoch_ != agingEpoch_)
+        {
+            normalizeFreqList(next);
+            cur = node->freqList_;
+            next = cur->nextList_;
+        }
+        if (!next || next->freq_ != cur->freq_ + 1)
+        {
+            next = insertFreqList(cur, cur->freq_ + 1);
+        }
+        cur->removeLfuNode(node);
+        next->addLfuNode(node);
+        if (cur->isEmpty())
         {
-            ++minFreq_;
+            releaseFreqList(cur);
         }
+        // 当前平均访问频次和当前访问所有缓存次数总数都需要更新
         addAccessFreq();
     }
 
     template <typename KEY, typename VALUE>
-    void myLfuCache<KEY, VALUE>::putInternal(KEY key, const VALUE &value)
+    template <typename K, typename V>
+    void myLfuCache<KEY, VALUE>::putInternal(K &&key, V &&value, uint64_t expireTick)
     {
-        // 如果当前缓存已满则删除最少访问的节点，如果有多个最少访问的节点，则删除最少访问中最近最少使用节点
-        if (LfuMap_.size() == capacity_)
+        // 超过整个预算的缓存项不缓存
+        size_t weight = weigh(key, value);
+        if (weight > capacity_)
+        {
+            return;
+        }
+        // 如果放不下则删除最少访问的节点，如果有多个最少访问的节点，则删除最少访问中最近最少使用节点
+        while (totalWeight_ + weight > capacity_ && !LfuMap_.empty())
         {
             removeForLfu();
         }
         // 添加新节点
-        NodePrt node = std::make_shared<LfuNodeType>(key, value);
+        NodePrt node = allocateNode();
+        node->key_ = key;
+        node->value_ = std::forward<V>(value);
+        node->weight_ = weight;
+        totalWeight_ += weight;
+        setExpiry(node, expireTick);
+        ++node->generation_;
         // 更新LfuMap
-        LfuMap_[key] = node;
-        // 更新key-频次链表
+        LfuMap_.emplace(std::forward<K>(key), node);
+        // 加入频次为1的桶
         addToFreqList(node);
         // 更新访问次数
         addAccessFreq();
-        // 更新最小访问次数
-        minFreq_ = std::min(minFreq_, static_cast<size_t>(1));
     }
 
     template <typename KEY, typename VALUE>
     void myLfuCache<KEY, VALUE>::removeFromFreqList(NodePrt node)
     {
-        if (!node)
+        if (!node || !node->freqList_)
             return;
 
-        auto freq = node->getAccessSize();   // 获取访问频次
-        auto it = keyToFreqList_.find(freq); // 找到链表
-        if (it != keyToFreqList_.end())
-            it->second->removeLfuNode(node);
+        FreqListPtr list = node->freqList_;
+        list->removeLfuNode(node);
+        if (list->isEmpty())
+        {
+            releaseFreqList(list);
+        }
     }
 
     template <typename KEY, typename VALUE>
@@ -336,16 +861,59 @@ namespace myCacheSystem
         if (!node)
             return;
 
-        auto freq = node->getAccessSize(); // 获取访问频次
+        // 频次为1的桶只可能是头部桶
+        if (freqHead_)
+        {
+            normalizeFreqList(freqHead_);
+        }
+        if (!freqHead_ || freqHead_->freq_ != 1)
+        {
+            insertFreqList(nullptr, 1);
+        }
+        freqHead_->addLfuNode(node);
+    }
 
-        auto it = keyToFreqList_.find(freq); // 找到链表
-        // 当前key没有对应的值，所以应该先创建
-        if (it == keyToFreqList_.end())
+    template <typename KEY, typename VALUE>
+    typename myLfuCache<KEY, VALUE>::FreqListPtr myLfuCache<KEY, VALUE>::insertFreqList(FreqListPtr prev, size_t freq)
+    {
+        FreqListPtr list = freqPool_.allocate();
+        list->freq_ = freq;
+        list->epoch_ = agingEpoch_;
+        list->prevList_ = prev;
+        list->nextList_ = prev ? prev->nextList_ : freqHead_;
+        if (list->nextList_)
         {
-            keyToFreqList_.emplace(freq, std::make_unique<FreqList<KEY, VALUE>>(freq));
+            list->nextList_->prevList_ = list;
         }
+        if (prev)
+        {
+            prev->nextList_ = list;
+        }
+        else
+        {
+            freqHead_ = list;
+        }
+        return list;
+    }
 
-        keyToFreqList_[freq]->addLfuNode(node);
+    template <typename KEY, typename VALUE>
+    void myLfuCache<KEY, VALUE>::releaseFreqList(FreqListPtr list)
+    {
+        if (list->prevList_)
+        {
+            list->prevList_->nextList_ = list->nextList_;
+        }
+        else
+        {
+            freqHead_ = list->nextList_;
+        }
+        if (list->nextList_)
+        {
+            list->nextList_->prevList_ = list->prevList_;
+        }
+        list->prevList_ = nullptr;
+        list->nextList_ = nullptr;
+        freqPool_.deallocate(list);
     }
 
     template <typename KEY, typename VALUE>
@@ -375,50 +943,148 @@ namespace myCacheSystem
             return;
         }
 
-        // 当前平均访问频次已经超过了最大平均访问频次，所有结点的访问频次- (maxAverageNum_ / 2)
-        for (auto it = LfuMap_.begin(); it != LfuMap_.end(); ++it)
+        /*
+            当前平均访问频次已经超过了最大平均访问频次，所有结点的访问频次统一衰减
+            这里只推进老化纪元，不遍历结点：各桶的频次在下次被访问、或者成为淘汰端时按落后的纪元数规整，
+            衰减函数单调，桶之间的顺序保持不变，只有降到相同频次的桶需要合并
+            访问总次数无法在不遍历的情况下精确得到，按所有结点都完整衰减估计
+        */
+        size_t size = LfuMap_.size();
+        size_t estimate = curTotalNum_;
+        if (decay_ == myLfuDecay::Halve)
         {
-            // 检查结点是否为空
-            if (!it->second)
-                continue;
-
-            NodePrt node = it->second;
-
-            // 从当前列表移除
-            removeFromFreqList(node);
+            estimate = curTotalNum_ / 2;
+        }
+        else
+        {
+            size_t step = maxAverageNum_ / 2;
+            if (step == 0)
+            {
+                return;
+            }
+            estimate = curTotalNum_ / size > step ? curTotalNum_ - step * size : 0;
+        }
+        ++agingEpoch_;
+        curTotalNum_ = std::max(estimate, size);
+        curAverageNum_ = curTotalNum_ / size;
+    }
 
-            // 减少频率
-            auto freq = node->getAccessSize();
-            freq -= maxAverageNum_ / 2;
-            node->setAccessSize(freq);
+    template <typename KEY, typename VALUE>
+    size_t myLfuCache<KEY, VALUE>::decayFreq(size_t freq, size_t epochs) const
+    {
+        if (decay_ == myLfuDecay::Halve)
+        {
+            return epochs >= 64 ? 1 : std::max<size_t>(freq >> epochs, 1);
+        }
+        // 每个纪元减去 maxAverageNum_ / 2，最低降到1
+        size_t step = maxAverageNum_ / 2;
+        if (step == 0)
+        {
+            return freq;
+        }
+        return (freq - 1) / step >= epochs ? freq - step * epochs : 1;
+    }
 
-            // 添加节点到对应的链表
-            addToFreqList(node);
+    template <typename KEY, typename VALUE>
+    typename myLfuCache<KEY, VALUE>::FreqListPtr myLfuCache<KEY, VALUE>::normalizeFreqList(FreqListPtr list)
+    {
+        if (list->epoch_ == agingEpoch_)
+        {
+            return list;
+        }
+        list->freq_ = decayFreq(list->freq_, agingEpoch_ - list->epoch_);
+        list->epoch_ = agingEpoch_;
+        // 已规整的相邻桶频次各不相同，只需要和两侧已规整的桶比较
+        FreqListPtr prev = list->prevList_;
+        if (prev && prev->epoch_ == agingEpoch_ && prev->freq_ == list->freq_)
+        {
+            list = mergeFreqList(prev, list);
+        }
+        FreqListPtr next = list->nextList_;
+        if (next && next->epoch_ == agingEpoch_ && next->freq_ == list->freq_)
+        {
+            list = mergeFreqList(list, next);
         }
+        return list;
+    }
 
-        // 更新最小频率
-        updateMinFreq();
+    template <typename KEY, typename VALUE>
+    typename myLfuCache<KEY, VALUE>::FreqListPtr myLfuCache<KEY, VALUE>::mergeFreqList(FreqListPtr low, FreqListPtr high)
+    {
+        /*
+            结点少的桶并入结点多的桶，每个结点被移动后所在桶的大小至少翻倍，移动次数有对数上界
+            low 中的结点原本频次更低，合并后排在前面，先被淘汰
+        */
+        if (low->size_ >= high->size_)
+        {
+            high->moveAllTo(*low);
+            releaseFreqList(high);
+            return low;
+        }
+        low->moveAllTo(*high, true);
+        releaseFreqList(low);
+        return high;
     }
 
     template <typename KEY, typename VALUE>
     void myLfuCache<KEY, VALUE>::removeForLfu()
     {
-        // 找到最少频次链表
-        auto it = keyToFreqList_.find(minFreq_);
-        // 找到该节点
-        NodePrt node = it->second->getFirstNode();
-        // 更新key-频次链表
+        // 头部桶即最小频次桶，规整后删除其中最先加入的结点
+        if (!freqHead_)
+            return;
+
+        eraseNode(normalizeFreqList(freqHead_)->getFirstNode());
+    }
+
+    template <typename KEY, typename VALUE>
+    void myLfuCache<KEY, VALUE>::eraseNode(NodePrt node)
+    {
+        normalizeFreqList(node->freqList_);
+        size_t freq = node->getAccessSize();
+        // 更新频次桶
         removeFromFreqList(node);
         // 更新key-node
-        LfuMap_.erase(node->getKey());
+        LfuMap_.erase(node->key_);
+        totalWeight_ -= node->weight_;
         // 更新频次
-        decreaseFreqNum(node->getAccessSize());
+        decreaseFreqNum(freq);
+        // 取消过期时间，结点归还给结点池
+        wheel_.cancel(node);
+        releaseNode(node);
+    }
+
+    template <typename KEY, typename VALUE>
+    typename myLfuCache<KEY, VALUE>::NodePrt myLfuCache<KEY, VALUE>::replacePinnedNode(NodePrt old)
+    {
+        NodePrt node = allocateNode();
+        node->key_ = old->key_;
+        node->weight_ = old->weight_;
+        ++node->generation_;
+        // 在频次桶中占据旧结点的位置
+        FreqListPtr list = old->freqList_;
+        node->freqList_ = list;
+        node->prev_ = old->prev_;
+        node->next_ = old->next_;
+        (node->prev_ ? node->prev_->next_ : list->head_) = node;
+        (node->next_ ? node->next_->prev_ : list->tail_) = node;
+        old->prev_ = nullptr;
+        old->next_ = nullptr;
+        old->freqList_ = nullptr;
+        LfuMap_.find(node->key_)->second = node;
+        if (old->hasExpiry())
+        {
+            wheel_.schedule(node, old->getExpireTick());
+        }
+        wheel_.cancel(old);
+        pinnedNodes_.retire(old);
+        return node;
     }
 
     template <typename KEY, typename VALUE>
     void myLfuCache<KEY, VALUE>::decreaseFreqNum(size_t freq)
     {
-        curTotalNum_ -= freq;
+        // 老化后总次数是估计值，避免下溢
+        curTotalNum_ -= std::min(freq, curTotalNum_);
         if (LfuMap_.empty())
         {
             curAverageNum_ = 0;
@@ -429,86 +1095,25 @@ namespace myCacheSystem
         }
     }
 
-    template <typename KEY, typename VALUE>
-    void myLfuCache<KEY, VALUE>::updateMinFreq()
-    {
-        minFreq_ = INT8_MAX;
-        // 循环查找key-频次链表
-        for (const auto &pair : keyToFreqList_)
-        {
-            if (pair.second && !pair.second->isEmpty())
-            {
-                minFreq_ = std::min(minFreq_, pair.first);
-            }
-        }
-        if (minFreq_ == INT8_MAX)
-            minFreq_ = 1;
-    }
-
     /*
         myhashLfuCache
+        每个分片是一个独立加锁的 myLfuCache，分片规则见 myShardedCache
     */
     template <typename KEY, typename VALUE>
-    class myHashLfuCache
+    class myHashLfuCache : public myShardedCache<KEY, VALUE, myLfuCache<KEY, VALUE>>
     {
+        typedef myShardedCache<KEY, VALUE, myLfuCache<KEY, VALUE>> Base;
+
     public:
         /*
             构造函数
         */
-        myHashLfuCache(size_t capacity, size_t sliceNum, size_t maxAverageNum = 10)
-            : capacity_(capacity), sliceNumber_(sliceNum > 0 ? sliceNum : std::thread::hardware_concurrency())
-        {
-            // 计算每个分片capacity
-            size_t sliceSize = std::ceil(static_cast<double>(capacity_) / static_cast<double>(sliceNumber_));
-            // 创建多个lfuCache
-            for (int i = 0; i < sliceNumber_; ++i)
-            {
-                lfuSliceCache_.emplace_back(std::make_unique<myLfuCache<KEY, VALUE>>(sliceSize, maxAverageNum));
-            }
-        }
-
-        /*
-            成员函数接口
-        */
-        void put(KEY key, VALUE value)
-        {
-            // 计算key对应的hash值
-            size_t hashKey = hashFunction(key) % sliceNumber_;
-            // 调用相应的缓存池put
-            lfuSliceCache_[hashKey]->put(key, value);
-        }
-
-        bool get(KEY key, VALUE &value)
-        {
-            size_t hashKey = hashFunction(key) % sliceNumber_;
-            return lfuSliceCache_[hashKey]->get(key, value);
-        }
-
-        VALUE get(KEY key)
-        {
-            VALUE value{};
-            get(key, value);
-            return value;
-        }
-
-        void clear()
+        // weigher: 非空时 capacity 为总权重预算，按分片平均分配
+        myHashLfuCache(size_t capacity, size_t sliceNum, size_t maxAverageNum = 10, myWeigher<KEY, VALUE> weigher = myWeigher<KEY, VALUE>(), myLfuDecay decay = myLfuDecay::Subtract)
+            : Base(capacity, sliceNum, [&](size_t sliceSize, size_t)
+                   { return std::make_unique<typename Base::Slice>(sliceSize, maxAverageNum, false, weigher, decay); })
         {
-            for (auto &lfuSliceItem : lfuSliceCache_)
-            {
-                lfuSliceItem->clear();
-            }
         }
-
-    private:
-        size_t hashFunction(KEY key) const
-        {
-            std::hash<KEY> hashFunc;
-            return hashFunc(key);
-        }
-
-        size_t capacity_;                                                    // 总容量
-        size_t sliceNumber_;                                                 // 分片数量
-        std::vector<std::unique_ptr<myLfuCache<KEY, VALUE>>> lfuSliceCache_; // 分片容器
     };
 }
 
@@ -0,0 +1,575 @@
+#ifndef MYLIRS_H
+#define MYLIRS_H
+
+#include <algorithm>
+#include <mutex>
+#include "myCachePolicy.h"
+#include "myNodePool.h"
+#include "myHash.h"
+#include "myFlatHashMap.h"
+#include "myTimingWheel.h"
+
+namespace myCacheSystem
+{
+    // 前向声明
+    template <typename KEY, typename VALUE>
+    class myLirsCache;
+
+    // 结点状态
+    enum class myLirsStatus : uint8_t
+    {
+        Lir,           // LIR：重用距离小，常驻
+        HirResident,   // 常驻HIR：在队列Q中，最先被淘汰
+        HirNonResident // 非常驻HIR：只在栈S中保留元数据，value已经释放
+    };
+
+    // LIRS的缓存节点，同时挂在栈S和队列上，继承时间轮钩子以支持过期时间
+    template <typename KEY, typename VALUE>
+    class myLirsNode : public myTimerNode
+    {
+        friend class myLirsCache<KEY, VALUE>;
+
+    public:
+        /*
+            构造函数
+        */
+        myLirsNode()
+            : status_(myLirsStatus::Lir), inStack_(false), stackPrev_(nullptr), stackNext_(nullptr), queuePrev_(nullptr), queueNext_(nullptr)
+        {
+        }
+
+        /*
+            成员函数接口
+        */
+        KEY getKey() const
+        {
+            return key_;
+        }
+
+        VALUE getValue() const
+        {
+            return value_;
+        }
+
+        myLirsStatus getStatus() const
+        {
+            return status_;
+        }
+
+        // 释放键值，结点归还 myNodePool 时调用，空闲栈中的结点不再占用键值的内存
+        void releasePayload()
+        {
+            key_ = KEY();
+            value_ = VALUE();
+        }
+
+    private:
+        KEY key_;
+        VALUE value_;
+        myLirsStatus status_;             // 结点状态
+        bool inStack_;                    // 是否在栈S中
+        myLirsNode<KEY, VALUE> *stackPrev_; // 栈S的链接，结点由myNodePool统一管理，使用裸指针侵入式链接
+        myLirsNode<KEY, VALUE> *stackNext_;
+        myLirsNode<KEY, VALUE> *queuePrev_; // 队列Q(常驻HIR)或非常驻队列的链接
+        myLirsNode<KEY, VALUE> *queueNext_;
+    };
+
+    /*
+        LIRS(Low Inter-reference Recency Set)缓存
+        1. 结点按重用距离分为LIR和HIR：LIR占容量的绝大部分，HIR只占 hirRatio(默认1%)，新key先成为HIR
+        2. 栈S按最近访问排序，记录LIR结点以及比栈底LIR更近访问过的HIR结点(包括已经淘汰了value的非常驻HIR)
+        3. HIR结点在栈S中再次被访问，说明它的重用距离小于栈底的LIR，升级为LIR，栈底的LIR降级为常驻HIR进入队列Q
+        4. 淘汰只发生在队列Q的队头(常驻HIR)，被淘汰的结点如果仍在栈S中就变为非常驻HIR，只保留key
+        5. 栈剪枝：栈底始终是LIR结点，栈底的HIR结点被移出栈S，非常驻HIR随之彻底删除
+        非常驻HIR另外按淘汰顺序排成一个队列，数量超过 nonResidentCapacity 时删除最早的记录，元数据的总量有上限
+        循环访问的范围超过容量时，LIR集合保持稳定，只有HIR在轮换，不会像LRU那样全部失效
+        所有操作在一把互斥锁内完成
+    */
+    template <typename KEY, typename VALUE>
+    class myLirsCache : public myCachePolicy<KEY, VALUE>
+    {
+    public:
+        typedef myLirsNode<KEY, VALUE> LirsNodeType;
+        typedef LirsNodeType *NodePtr;
+        typedef myFlatHashMap<KEY, NodePtr> NodeMap;
+        typedef myNodePool<LirsNodeType> NodePool;
+        typedef myTimingWheel<LirsNodeType> TimingWheel;
+
+        static constexpr size_t kExpireBudget = 16; // 每次写操作最多回收的过期结点数
+
+        /*
+            构造函数
+        */
+        // hirRatio: 常驻HIR占容量的比例(至少1个，容量为1时为0)
+        // nonResidentCapacity: 非常驻HIR记录的上限，0表示与 capacity 相同
+        explicit myLirsCache(size_t capacity, double hirRatio = 0.01, size_t nonResidentCapacity = 0)
+            : capacity_(capacity),
+              nonResidentCapacity_(nonResidentCapacity > 0 ? nonResidentCapacity : capacity),
+              lirCount_(0),
+              residentCount_(0),
+              pool_(capacity_ + nonResidentCapacity_ + 6)
+        {
+            size_t hirCapacity = capacity_ >= 2 ? std::clamp<size_t>(static_cast<size_t>(capacity_ * hirRatio), 1, capacity_ - 1) : 0;
+            lirCapacity_ = capacity_ - hirCapacity;
+            stackHead_ = pool_.allocate();
+            stackTail_ = pool_.allocate();
+            stackHead_->stackNext_ = stackTail_;
+            stackTail_->stackPrev_ = stackHead_;
+            queueInit(hirQueue_);
+            queueInit(nonResidentQueue_);
+            nodeMap_.reserve(capacity_ + nonResidentCapacity_);
+        }
+
+        ~myLirsCache() override = default;
+
+        /*
+            成员函数接口
+        */
+        // 添加缓存
+        virtual void put(const KEY &key, const VALUE &value) override
+        {
+            putImpl(key, value);
+        }
+
+        virtual void put(KEY &&key, VALUE &&value) override
+        {
+            putImpl(std::move(key), std::move(value));
+        }
+
+        // 添加带过期时间的缓存
+        virtual void put(const KEY &key, const VALUE &value, std::chrono::milliseconds ttl) override
+        {
+            putImpl(key, value, myTimingWheelDeadline(ttl));
+        }
+
+        virtual void put(KEY &&key, VALUE &&value, std::chrono::milliseconds ttl) override
+        {
+            putImpl(std::move(key), std::move(value), myTimingWheelDeadline(ttl));
+        }
+
+        // 获取value
+        virtual bool get(const KEY &key, VALUE &value) override
+        {
+            return getImpl(key, value);
+        }
+
+        virtual VALUE get(const KEY &key) override
+        {
+            VALUE value{};
+            getImpl(key, value);
+            return value;
+        }
+
+        // 透明查找：std::string 键可以直接用 std::string_view 查询
+        template <typename K, typename = std::enable_if_t<myIsTransparentKey_v<KEY, K>>>
+        bool get(const K &key, VALUE &value)
+        {
+            return getImpl(key, value);
+        }
+
+        template <typename K, typename = std::enable_if_t<myIsTransparentKey_v<KEY, K>>>
+        VALUE get(const K &key)
+        {
+            VALUE value{};
+            getImpl(key, value);
+            return value;
+        }
+
+        // 非阻塞接口
+        virtual myTryStatus tryGet(const KEY &key, VALUE &value) override
+        {
+            return lookup<true>(key, value);
+        }
+
+        virtual bool tryPut(const KEY &key, const VALUE &value) override
+        {
+            return putImpl<true>(key, value);
+        }
+
+        virtual bool tryPut(const KEY &key, const VALUE &value, std::chrono::milliseconds ttl) override
+        {
+            return putImpl<true>(key, value, myTimingWheelDeadline(ttl));
+        }
+
+        // 清空缓存和所有元数据
+        void clear()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto &pair : nodeMap_)
+            {
+                pool_.deallocate(pair.second);
+            }
+            nodeMap_.clear();
+            stackHead_->stackNext_ = stackTail_;
+            stackTail_->stackPrev_ = stackHead_;
+            for (Queue *queue : {&hirQueue_, &nonResidentQueue_})
+            {
+                queue->head_->queueNext_ = queue->tail_;
+                queue->tail_->queuePrev_ = queue->head_;
+                queue->size_ = 0;
+            }
+            wheel_.clear();
+            lirCount_ = 0;
+            residentCount_ = 0;
+        }
+
+        // 常驻缓存项数量
+        size_t size() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return residentCount_;
+        }
+
+        // 非常驻HIR记录数量
+        size_t nonResidentSize() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return nonResidentQueue_.size_;
+        }
+
+    private:
+        // 队列，头部最早进入
+        struct Queue
+        {
+            NodePtr head_ = nullptr; // 虚拟头结点
+            NodePtr tail_ = nullptr; // 虚拟尾结点
+            size_t size_ = 0;        // 结点数
+        };
+
+        /*
+            私有成员函数方法
+        */
+        void queueInit(Queue &queue)
+        {
+            queue.head_ = pool_.allocate();
+            queue.tail_ = pool_.allocate();
+            queue.head_->queueNext_ = queue.tail_;
+            queue.tail_->queuePrev_ = queue.head_;
+        }
+
+        // 压入栈顶
+        void stackPush(NodePtr node)
+        {
+            NodePtr prev = stackTail_->stackPrev_;
+            prev->stackNext_ = node;
+            node->stackNext_ = stackTail_;
+            stackTail_->stackPrev_ = node;
+            node->stackPrev_ = prev;
+            node->inStack_ = true;
+        }
+
+        void stackRemove(NodePtr node)
+        {
+            node->stackPrev_->stackNext_ = node->stackNext_;
+            node->stackNext_->stackPrev_ = node->stackPrev_;
+            node->stackPrev_ = nullptr;
+            node->stackNext_ = nullptr;
+            node->inStack_ = false;
+        }
+
+        // 栈底结点，栈为空时返回nullptr
+        NodePtr stackBottom() const
+        {
+            return stackHead_->stackNext_ != stackTail_ ? stackHead_->stackNext_ : nullptr;
+        }
+
+        // 加入队尾
+        void queuePush(Queue &queue, NodePtr node)
+        {
+            NodePtr prev = queue.tail_->queuePrev_;
+            prev->queueNext_ = node;
+            node->queueNext_ = queue.tail_;
+            queue.tail_->queuePrev_ = node;
+            node->queuePrev_ = prev;
+            ++queue.size_;
+        }
+
+        void queueRemove(Queue &queue, NodePtr node)
+        {
+            node->queuePrev_->queueNext_ = node->queueNext_;
+            node->queueNext_->queuePrev_ = node->queuePrev_;
+            node->queuePrev_ = nullptr;
+            node->queueNext_ = nullptr;
+            --queue.size_;
+        }
+
+        // 队头结点，队列为空时返回nullptr
+        NodePtr queueFront(const Queue &queue) const
+        {
+            return queue.size_ > 0 ? queue.head_->queueNext_ : nullptr;
+        }
+
+        // TRY 为 true 时锁被占用直接返回false
+        template <bool TRY = false, typename K, typename V>
+        bool putImpl(K &&key, V &&value, uint64_t expireTick = 0)
+        {
+            if (capacity_ <= 0)
+                return true;
+
+            std::unique_lock<std::mutex> lock(mutex_, std::defer_lock);
+            if (!myAcquireLock<TRY>(lock))
+            {
+                return false;
+            }
+            expireEntries();
+            auto it = nodeMap_.find(key);
+            if (it != nodeMap_.end() && it->second->status_ != myLirsStatus::HirNonResident)
+            {
+                // 常驻：更新值和过期时间，按一次访问处理
+                NodePtr node = it->second;
+                node->value_ = std::forward<V>(value);
+                setExpiry(node, expireTick);
+                onHit(node);
+                return true;
+            }
+
+            // 未命中：先腾出一个常驻位置(可能会删除非常驻记录，所以之后重新查找)
+            while (residentCount_ >= capacity_)
+            {
+                evictResident();
+            }
+            it = nodeMap_.find(key);
+            NodePtr node = nullptr;
+            if (it != nodeMap_.end())
+            {
+                // 非常驻HIR再次被访问：重用距离小于栈底LIR，升级为LIR
+                node = it->second;
+                queueRemove(nonResidentQueue_, node);
+                stackRemove(node);
+                node->value_ = std::forward<V>(value);
+                node->status_ = myLirsStatus::Lir;
+                ++lirCount_;
+                stackPush(node);
+            }
+            else
+            {
+                node = pool_.allocate();
+                node->key_ = key;
+                node->value_ = std::forward<V>(value);
+                stackPush(node);
+                if (lirCount_ < lirCapacity_)
+                {
+                    // LIR集合未满(冷启动)，直接成为LIR
+                    node->status_ = myLirsStatus::Lir;
+                    ++lirCount_;
+                }
+                else
+                {
+                    node->status_ = myLirsStatus::HirResident;
+                    queuePush(hirQueue_, node);
+                }
+                nodeMap_.emplace(std::forward<K>(key), node);
+            }
+            ++residentCount_;
+            setExpiry(node, expireTick);
+            demoteLir();
+            return true;
+        }
+
+        template <typename K>
+        bool getImpl(const K &key, VALUE &value)
+        {
+            return lookup(key, value) == myTryStatus::Hit;
+        }
+
+        // 命中时拷贝value并按一次访问处理；TRY 为 true 时锁被占用直接返回 Busy
+        template <bool TRY = false, typename K>
+        myTryStatus lookup(const K &key, VALUE &value)
+        {
+            std::unique_lock<std::mutex> lock(mutex_, std::defer_lock);
+            if (!myAcquireLock<TRY>(lock))
+            {
+                return myTryStatus::Busy;
+            }
+            expireEntries();
+            auto it = nodeMap_.find(key);
+            if (it == nodeMap_.end() || it->second->status_ == myLirsStatus::HirNonResident || isExpired(it->second))
+            {
+                return myTryStatus::Miss;
+            }
+            value = it->second->value_;
+            onHit(it->second);
+            return myTryStatus::Hit;
+        }
+
+        // 访问常驻结点
+        void onHit(NodePtr node)
+        {
+            if (node->status_ == myLirsStatus::Lir)
+            {
+                // LIR移到栈顶，原来在栈底时需要剪枝
+                bool wasBottom = stackBottom() == node;
+                stackRemove(node);
+                stackPush(node);
+                if (wasBottom)
+                {
+                    prune();
+                }
+                return;
+            }
+
+            // 常驻HIR
+            if (node->inStack_ || lirCount_ < lirCapacity_)
+            {
+                // 在栈S中(或者LIR集合未满)：升级为LIR，栈底LIR降级
+                if (node->inStack_)
+                {
+                    stackRemove(node);
+                }
+                stackPush(node);
+                queueRemove(hirQueue_, node);
+                node->status_ = myLirsStatus::Lir;
+                ++lirCount_;
+                demoteLir();
+            }
+            else
+            {
+                // 不在栈S中：仍是HIR，压入栈顶并移到队列Q的队尾
+                stackPush(node);
+                queueRemove(hirQueue_, node);
+                queuePush(hirQueue_, node);
+            }
+        }
+
+        // LIR超过容量时，栈底LIR降级为常驻HIR进入队列Q
+        void demoteLir()
+        {
+            while (lirCount_ > lirCapacity_)
+            {
+                NodePtr bottom = stackBottom();
+                stackRemove(bottom);
+                bottom->status_ = myLirsStatus::HirResident;
+                --lirCount_;
+                queuePush(hirQueue_, bottom);
+                prune();
+            }
+        }
+
+        // 栈剪枝：移出栈底的HIR结点，直到栈底是LIR；非常驻HIR彻底删除
+        void prune()
+        {
+            NodePtr bottom = stackBottom();
+            while (bottom && bottom->status_ != myLirsStatus::Lir)
+            {
+                stackRemove(bottom);
+                if (bottom->status_ == myLirsStatus::HirNonResident)
+                {
+                    queueRemove(nonResidentQueue_, bottom);
+                    releaseNode(bottom);
+                }
+                bottom = stackBottom();
+            }
+        }
+
+        // 淘汰队列Q的队头，仍在栈S中的结点变为非常驻HIR
+        void evictResident()
+        {
+            NodePtr victim = queueFront(hirQueue_);
+            if (!victim)
+            {
+                // 没有常驻HIR(容量为1或者HIR都过期了)，先把栈底LIR降级
+                NodePtr bottom = stackBottom();
+                stackRemove(bottom);
+                bottom->status_ = myLirsStatus::HirResident;
+                --lirCount_;
+                queuePush(hirQueue_, bottom);
+                prune();
+                victim = bottom;
+            }
+            queueRemove(hirQueue_, victim);
+            --residentCount_;
+            wheel_.cancel(victim);
+            if (!victim->inStack_)
+            {
+                releaseNode(victim);
+                return;
+            }
+            victim->status_ = myLirsStatus::HirNonResident;
+            victim->value_ = VALUE();
+            queuePush(nonResidentQueue_, victim);
+            // 非常驻记录超过上限，删除最早的记录
+            while (nonResidentQueue_.size_ > nonResidentCapacity_)
+            {
+                NodePtr oldest = queueFront(nonResidentQueue_);
+                queueRemove(nonResidentQueue_, oldest);
+                stackRemove(oldest);
+                releaseNode(oldest);
+            }
+        }
+
+        // 删除常驻结点(过期)，不留下非常驻记录
+        void eraseNode(NodePtr node)
+        {
+            if (node->status_ == myLirsStatus::Lir)
+            {
+                --lirCount_;
+            }
+            else
+            {
+                queueRemove(hirQueue_, node);
+            }
+            if (node->inStack_)
+            {
+                stackRemove(node);
+            }
+            --residentCount_;
+            wheel_.cancel(node);
+            releaseNode(node);
+            prune();
+        }
+
+        // 从哈希表删除并归还结点池(结点已经不在任何链表中)
+        void releaseNode(NodePtr node)
+        {
+            nodeMap_.erase(node->key_);
+            node->inStack_ = false;
+            pool_.deallocate(node);
+        }
+
+        // 结点是否已经过期
+        bool isExpired(NodePtr node) const
+        {
+            return node->hasExpiry() && node->isExpired(myTimingWheelNow());
+        }
+
+        // 推进时间轮，回收最多 kExpireBudget 个过期结点(调用者持有锁)
+        void expireEntries()
+        {
+            if (wheel_.empty())
+            {
+                return;
+            }
+            wheel_.expire(myTimingWheelNow(), kExpireBudget, [this](NodePtr node)
+                          { eraseNode(node); });
+        }
+
+        // 设置结点的过期刻度，0表示不过期
+        void setExpiry(NodePtr node, uint64_t expireTick)
+        {
+            if (expireTick != 0)
+            {
+                wheel_.schedule(node, expireTick);
+            }
+            else
+            {
+                wheel_.cancel(node);
+            }
+        }
+
+        size_t capacity_;            // 常驻结点容量
+        size_t lirCapacity_;         // LIR集合容量
+        size_t nonResidentCapacity_; // 非常驻HIR记录上限
+        size_t lirCount_;            // LIR结点数
+        size_t residentCount_;       // 常驻结点数(LIR + 常驻HIR)
+        mutable std::mutex mutex_;   // 互斥锁
+        NodePool pool_;              // 结点池(含栈和两个队列的虚拟头尾结点)
+        NodeMap nodeMap_;            // key——结点映射(包括非常驻HIR)
+        TimingWheel wheel_;          // 时间轮，管理设置了过期时间的常驻结点
+        NodePtr stackHead_;          // 栈S的虚拟栈底
+        NodePtr stackTail_;          // 栈S的虚拟栈顶
+        Queue hirQueue_;             // 队列Q：常驻HIR
+        Queue nonResidentQueue_;     // 非常驻HIR，按变为非常驻的顺序排列
+    };
+} // namespace myCacheSystem
+
+#endif // MYLIRS_H
@@ -3,11 +3,21 @@
 
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
+#include <atomic>
 #include <vector>
-#include <unordered_map>
 #include <thread>
 #include <cmath>
 #include "myCachePolicy.h"
+#include "myNodePool.h"
+#include "myHash.h"
+#include "myFlatHashMap.h"
+#include "myReadBuffer.h"
+#include "myAccessHistory.h"
+#include "myTimingWheel.h"
+#include "myShardedCache.h"
+#include "myValueHandle.h"
+#include "myRefreshAhead.h"
 
 namespace myCacheSystem
 {
@@ -15,20 +25,43 @@ namespace myCacheSystem
     template <typename KEY, typename VALUE>
     class myLruCache;
 
-    // LRU的缓存节点
     template <typename KEY, typename VALUE>
-    class myLruNode
+    class mySlruCache;
+
+    template <typename KEY, typename VALUE>
+    class my2QCache;
+
+    /*
+        LRU缓存的工作模式
+        Strict: 严格LRU，命中时在写锁下把结点移动到链表末尾
+        Clock:  CLOCK/second-chance 近似LRU，命中只设置结点的原子访问位(relaxed)，只需要读锁，
+                淘汰时从链表头部扫描，访问位为1的结点清零后移到末尾(第二次机会)，为0的结点淘汰
+        Buffered: 命中在读锁下记录到条带化的读缓冲区，由持有写锁的线程批量回放提升，
+                缓冲区满时读线程尝试获取写锁回放，获取失败则直接返回(提升被推迟或丢弃)
+    */
+    enum class myLruMode
+    {
+        Strict,
+        Clock,
+        Buffered
+    };
+
+    // LRU的缓存节点，继承时间轮钩子以支持过期时间
+    template <typename KEY, typename VALUE>
+    class myLruNode : public myTimerNode
     {
         friend class myLruCache<KEY, VALUE>;
+        friend class mySlruCache<KEY, VALUE>;
+        friend class my2QCache<KEY, VALUE>;
 
     public:
         /*
             构造函数
         */
         // 默认构造
-        myLruNode() : accessCount_(1), next_(nullptr) {};
+        myLruNode() : accessCount_(1), weight_(1), referenced_(false), pinned_(false), generation_(0), prev_(nullptr), next_(nullptr) {};
         // 有参构造
-        myLruNode(KEY key, VALUE value) : key_(key), value_(value), accessCount_(1), next_(nullptr) {}
+        myLruNode(KEY key, VALUE value) : key_(key), value_(value), accessCount_(1), weight_(1), referenced_(false), pinned_(false), generation_(0), prev_(nullptr), next_(nullptr) {}
 
         /*
             成员函数接口
@@ -48,12 +81,26 @@ namespace myCacheSystem
         // 增加访问次数
         void addAccessCount() { ++this->accessCount_; }
 
+        // 获取权重
+        size_t getWeight() const { return this->weight_; }
+
+        // 释放键值，结点归还 myNodePool 时调用，空闲栈中的结点不再占用键值的内存
+        void releasePayload()
+        {
+            key_ = KEY();
+            value_ = VALUE();
+        }
+
     private:
-        KEY key_;                                     // 键
-        VALUE value_;                                 // 值
-        size_t accessCount_;                          // 访问次数
-        std::weak_ptr<myLruNode<KEY, VALUE>> prev_;   // 前向节点 weak_ptr打破循环引用
-        std::shared_ptr<myLruNode<KEY, VALUE>> next_; // 后向节点 shared_ptr自动释放
+        KEY key_;                        // 键
+        VALUE value_;                    // 值
+        size_t accessCount_;             // 访问次数
+        size_t weight_;                  // 权重，由缓存的权重函数计算
+        std::atomic<bool> referenced_;   // CLOCK模式的访问位，读锁下并发设置
+        std::atomic<bool> pinned_;       // 是否交出过句柄(getHandle)，读锁下并发设置；为true时不能原地修改或立即复用
+        uint32_t generation_;            // 结点代数，每次从结点池复用时加一，用于校验读缓冲区中的记录
+        myLruNode<KEY, VALUE> *prev_;    // 前向节点 结点由myNodePool统一管理，使用裸指针侵入式链接
+        myLruNode<KEY, VALUE> *next_;    // 后向节点
     };
 
     // LRU缓存池
@@ -62,16 +109,37 @@ namespace myCacheSystem
     {
     public:
         using LruNodeType = myLruNode<KEY, VALUE>;
-        using NodePtr = std::shared_ptr<LruNodeType>;
-        using NodeMap = std::unordered_map<KEY, NodePtr>;
+        using NodePtr = LruNodeType *;
+        using NodeMap = myFlatHashMap<KEY, NodePtr>;
+        using NodePool = myNodePool<LruNodeType>;
+        using ReadBuffer = myReadBuffer<LruNodeType>;
+        using Weigher = myWeigher<KEY, VALUE>;
+        using TimingWheel = myTimingWheel<LruNodeType>;
+        using PinnedNodes = myPinnedNodes<LruNodeType>;
+        using RefreshAhead = myRefreshAhead<KEY, VALUE>;
+
+        static constexpr size_t kExpireBudget = 16; // 每次写操作最多回收的过期结点数
 
         /*
             构造函数
         */
-        // 有参构造
-        explicit myLruCache(size_t capacity) : capacity_(capacity) { this->lruNodeListInit(); }
+        // 有参构造 结点池预分配 capacity + 2(虚拟头尾结点) 个结点
+        // weigher 非空时 capacity 为权重预算(如字节数)，结点数量无法预知，结点池按需扩容
+        explicit myLruCache(size_t capacity, myLruMode mode = myLruMode::Strict, Weigher weigher = Weigher())
+            : capacity_(capacity), totalWeight_(0), mode_(mode), weigher_(std::move(weigher)), pool_(weigher_ ? 2 : capacity + 2)
+        {
+            if (!weigher_)
+            {
+                nodeMap_.reserve(capacity_);
+            }
+            if (mode_ == myLruMode::Buffered)
+            {
+                readBuffer_ = std::make_unique<ReadBuffer>();
+            }
+            this->lruNodeListInit();
+        }
 
-        // 析构函数
+        // 析构函数 结点内存由pool_统一释放
         virtual ~myLruCache() override = default;
 
         /*
@@ -87,66 +155,161 @@ namespace myCacheSystem
             4. 访问一个数据但该数据不存在于缓存空间中，返回 - 1 表示缓存中无该数据。
         */
         // 添加缓存
-        virtual void put(KEY key, VALUE value) override
+        virtual void put(const KEY &key, const VALUE &value) override
         {
-            // 1. 判断内存大小是否足够
-            if (this->capacity_ <= 0)
-            {
-                return;
-            }
+            this->putImpl(key, value);
+        }
 
-            // 2. 缓存区为资源，要加互斥锁，避免竞争
-            std::lock_guard<std::mutex> lock(this->mutex_);
-            // 3. 查找key是否已经存在，存在则更新value，不存在则添加
-            auto it = this->nodeMap_.find(key);
-            if (it != nodeMap_.end())
-            {
-                updataLruNode(it->second, value);
-                return;
-            }
-            addLruNode(key, value);
+        virtual void put(KEY &&key, VALUE &&value) override
+        {
+            this->putImpl(std::move(key), std::move(value));
+        }
+
+        // 添加带过期时间的缓存
+        virtual void put(const KEY &key, const VALUE &value, std::chrono::milliseconds ttl) override
+        {
+            this->putImpl(key, value, myTimingWheelDeadline(ttl));
+        }
+
+        virtual void put(KEY &&key, VALUE &&value, std::chrono::milliseconds ttl) override
+        {
+            this->putImpl(std::move(key), std::move(value), myTimingWheelDeadline(ttl));
         }
 
         // 获取value
-        virtual bool get(KEY key, VALUE &value) override
+        virtual bool get(const KEY &key, VALUE &value) override
         {
-            // 添加锁，避免竞争
-            std::lock_guard<std::mutex> lock(this->mutex_);
-            auto it = this->nodeMap_.find(key);
-            if (it != nodeMap_.end())
-            {
-                this->removeToRecent(it->second);
-                value = it->second->getValue();
-                return true;
-            }
-            return false;
+            return this->getImpl(key, value);
         }
 
         // 访问缓存数据函数
-        virtual VALUE get(KEY key) override
+        virtual VALUE get(const KEY &key) override
+        {
+            VALUE value{};
+            this->getImpl(key, value);
+            return value;
+        }
+
+        // 透明查找：std::string 键可以直接用 std::string_view 查询
+        template <typename K, typename = std::enable_if_t<myIsTransparentKey_v<KEY, K>>>
+        bool get(const K &key, VALUE &value)
+        {
+            return this->getImpl(key, value);
+        }
+
+        template <typename K, typename = std::enable_if_t<myIsTransparentKey_v<KEY, K>>>
+        VALUE get(const K &key)
         {
             VALUE value{};
-            this->get(key, value);
+            this->getImpl(key, value);
             return value;
         }
 
+        // 非阻塞接口
+        virtual myTryStatus tryGet(const KEY &key, VALUE &value) override
+        {
+            return this->template lookup<true>(key, [&](NodePtr node)
+                                               { value = node->value_; });
+        }
+
+        virtual bool tryPut(const KEY &key, const VALUE &value) override
+        {
+            return this->template putImpl<true>(key, value);
+        }
+
+        virtual bool tryPut(const KEY &key, const VALUE &value, std::chrono::milliseconds ttl) override
+        {
+            return this->template putImpl<true>(key, value, myTimingWheelDeadline(ttl));
+        }
+
+        // 零拷贝读取：返回指向缓存中value的句柄，命中的处理与 get 相同，见 myValueHandle
+        template <typename K>
+        myValueHandle<VALUE> getHandle(const K &key)
+        {
+            auto guard = this->pinnedNodes_.pin();
+            const VALUE *value = nullptr;
+            this->lookup(key, [&](NodePtr node)
+                         {
+                node->pinned_.store(true, std::memory_order_relaxed);
+                value = &node->value_; });
+            return value ? myValueHandle<VALUE>(std::move(guard), value) : myValueHandle<VALUE>();
+        }
+
+        // 批量查询：整批只加一次锁
+        virtual size_t getMany(std::span<const KEY> keys, std::span<VALUE> values, std::vector<bool> &hits) override
+        {
+            hits.assign(keys.size(), false);
+            return this->getManyImpl(keys.size(), [](size_t i)
+                                     { return i; }, keys, values, hits);
+        }
+
+        // 只查询 indexes 指定的位置，结果写入 values/hits 的相同位置(供分片缓存按分片分组后调用)
+        size_t getMany(std::span<const KEY> keys, std::span<const size_t> indexes, std::span<VALUE> values, std::vector<bool> &hits)
+        {
+            return this->getManyImpl(indexes.size(), [&](size_t i)
+                                     { return indexes[i]; }, keys, values, hits);
+        }
+
+        // 批量添加：整批只加一次锁
+        virtual void putMany(std::span<const KEY> keys, std::span<const VALUE> values) override
+        {
+            this->putManyImpl(keys.size(), [](size_t i)
+                              { return i; }, keys, values);
+        }
+
+        void putMany(std::span<const KEY> keys, std::span<const size_t> indexes, std::span<const VALUE> values)
+        {
+            this->putManyImpl(indexes.size(), [&](size_t i)
+                              { return indexes[i]; }, keys, values);
+        }
+
         // 删除指定结点
-        void remove(KEY key)
+        template <typename K>
+        void remove(const K &key)
         {
-            std::lock_guard<std::mutex> lock(this->mutex_);
+            std::lock_guard<std::shared_mutex> lock(this->mutex_);
+            this->drainReadBuffer();
             auto it = this->nodeMap_.find(key);
             if (it != this->nodeMap_.end())
             {
-                this->removeNode(it->second);
-                this->nodeMap_.erase(it);
+                this->eraseNode(it->second);
             }
         }
 
+        // 当前缓存的总权重(未设置权重函数时即缓存项数量)
+        size_t weight() const
+        {
+            std::shared_lock<std::shared_mutex> lock(this->mutex_);
+            return this->totalWeight_;
+        }
+
+        // 开启写入后刷新：写入 refreshAfter 之后的命中返回旧值，并在 executor 上用 loader 重新加载一次，见 myRefreshAhead
+        void enableRefresh(std::chrono::milliseconds refreshAfter, typename RefreshAhead::Loader loader, myExecutor &executor = myExecutor::defaultExecutor(),
+                           std::shared_ptr<myRefreshBudget> budget = nullptr)
+        {
+            std::lock_guard<std::shared_mutex> lock(this->mutex_);
+            this->refresh_.enable(refreshAfter, std::move(loader), [this](const KEY &key, VALUE &&value, uint64_t expireTick)
+                                  { this->refreshIfPending(key, std::move(value), expireTick); }, executor, std::move(budget));
+        }
+
         // 清除缓存
         void clear()
         {
-            std::lock_guard<std::mutex> lock(mutex_);
+            std::lock_guard<std::shared_mutex> lock(mutex_);
+            this->drainReadBuffer();
+            // 把所有结点归还给结点池
+            NodePtr node = head_->next_;
+            while (node != tail_)
+            {
+                NodePtr next = node->next_;
+                node->prev_ = nullptr;
+                node->next_ = nullptr;
+                releaseNode(node);
+                node = next;
+            }
             nodeMap_.clear();
+            wheel_.clear();
+            totalWeight_ = 0;
             head_->next_ = tail_;
             tail_->prev_ = head_;
         }
@@ -162,6 +325,257 @@ namespace myCacheSystem
         }
 #endif
 
+    protected:
+        /*
+            键值以转发引用传入，右值直接移动进结点，避免拷贝
+        */
+        // expireTick: 过期刻度，0表示不过期；TRY 为 true 时写锁被占用直接返回false
+        template <bool TRY = false, typename K, typename V>
+        bool putImpl(K &&key, V &&value, uint64_t expireTick = 0)
+        {
+            // 1. 判断内存大小是否足够
+            if (this->capacity_ <= 0)
+            {
+                return true;
+            }
+
+            // 2. 缓存区为资源，要加互斥锁，避免竞争；顺带回放读缓冲区、回收过期结点
+            std::unique_lock<std::shared_mutex> lock(this->mutex_, std::defer_lock);
+            if (!myAcquireLock<TRY>(lock))
+            {
+                return false;
+            }
+            this->drainReadBuffer();
+            this->expireEntries();
+            this->putLocked(std::forward<K>(key), std::forward<V>(value), expireTick);
+            return true;
+        }
+
+        // 查找key是否已经存在，存在则更新value，不存在则添加(调用者持有写锁)
+        template <typename K, typename V>
+        void putLocked(K &&key, V &&value, uint64_t expireTick = 0)
+        {
+            auto it = this->nodeMap_.find(key);
+            if (it != nodeMap_.end())
+            {
+                updataLruNode(it->second, std::forward<V>(value), expireTick);
+                return;
+            }
+            addLruNode(std::forward<K>(key), std::forward<V>(value), expireTick);
+        }
+
+        // 命中时按工作模式更新结点并拷贝value(Strict/Buffered需持有写锁，Clock持有读锁即可)
+        template <typename K>
+        bool getLocked(const K &key, VALUE &value)
+        {
+            return this->visitLocked(key, [&](NodePtr node)
+                                     { value = node->value_; });
+        }
+
+        // 命中时按工作模式更新结点，并在锁内调用 visit(node)
+        template <typename K, typename VISIT>
+        bool visitLocked(const K &key, VISIT &&visit)
+        {
+            auto it = this->nodeMap_.find(key);
+            if (it == nodeMap_.end() || this->isExpired(it->second))
+            {
+                return false;
+            }
+            NodePtr node = it->second;
+            if (this->mode_ == myLruMode::Clock)
+            {
+                node->referenced_.store(true, std::memory_order_relaxed);
+            }
+            else
+            {
+                this->removeToRecent(node);
+            }
+            this->refresh_.onHit(node);
+            visit(node);
+            return true;
+        }
+
+        // 批量查询，indexAt(i) 给出第i个要查询的下标
+        template <typename INDEX>
+        size_t getManyImpl(size_t count, INDEX &&indexAt, std::span<const KEY> keys, std::span<VALUE> values, std::vector<bool> &hits)
+        {
+            size_t hitCount = 0;
+            auto lookup = [&]()
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    size_t index = indexAt(i);
+                    if (this->getLocked(keys[index], values[index]))
+                    {
+                        hits[index] = true;
+                        ++hitCount;
+                    }
+                }
+            };
+
+            // CLOCK模式只需要读锁；其他模式加一次写锁，Buffered模式直接提升不再经过读缓冲区
+            if (this->mode_ == myLruMode::Clock)
+            {
+                std::shared_lock<std::shared_mutex> lock(this->mutex_);
+                lookup();
+                return hitCount;
+            }
+            std::lock_guard<std::shared_mutex> lock(this->mutex_);
+            this->drainReadBuffer();
+            this->expireEntries();
+            lookup();
+            return hitCount;
+        }
+
+        // 批量添加
+        template <typename INDEX>
+        void putManyImpl(size_t count, INDEX &&indexAt, std::span<const KEY> keys, std::span<const VALUE> values)
+        {
+            if (this->capacity_ <= 0)
+            {
+                return;
+            }
+            std::lock_guard<std::shared_mutex> lock(this->mutex_);
+            this->drainReadBuffer();
+            this->expireEntries();
+            for (size_t i = 0; i < count; ++i)
+            {
+                size_t index = indexAt(i);
+                this->putLocked(keys[index], values[index]);
+            }
+        }
+
+        // 批量更新已经在缓存中的key，updated 标记被更新的下标
+        template <typename INDEX>
+        void updateManyIfExists(size_t count, INDEX &&indexAt, std::span<const KEY> keys, std::span<const VALUE> values, std::vector<bool> &updated)
+        {
+            std::lock_guard<std::shared_mutex> lock(this->mutex_);
+            this->drainReadBuffer();
+            for (size_t i = 0; i < count; ++i)
+            {
+                size_t index = indexAt(i);
+                auto it = this->nodeMap_.find(keys[index]);
+                if (it != nodeMap_.end() && !this->isExpired(it->second))
+                {
+                    updataLruNode(it->second, values[index], 0);
+                    updated[index] = true;
+                }
+            }
+        }
+
+        template <typename K>
+        bool getImpl(const K &key, VALUE &value)
+        {
+            return this->lookup(key, [&](NodePtr node)
+                                { value = node->value_; }) == myTryStatus::Hit;
+        }
+
+        // 按工作模式查找key，命中时在锁内调用 visit(node)；TRY 为 true 时锁被占用直接返回 Busy
+        template <bool TRY = false, typename K, typename VISIT>
+        myTryStatus lookup(const K &key, VISIT &&visit)
+        {
+            // CLOCK模式：只加读锁，命中只设置访问位，不修改链表
+            if (this->mode_ == myLruMode::Clock)
+            {
+                std::shared_lock<std::shared_mutex> lock(this->mutex_, std::defer_lock);
+                if (!myAcquireLock<TRY>(lock))
+                {
+                    return myTryStatus::Busy;
+                }
+                auto it = this->nodeMap_.find(key);
+                if (it == nodeMap_.end() || this->isExpired(it->second))
+                {
+                    return myTryStatus::Miss;
+                }
+                it->second->referenced_.store(true, std::memory_order_relaxed);
+                this->refresh_.onHit(it->second);
+                visit(it->second);
+                return myTryStatus::Hit;
+            }
+
+            // Buffered模式：读锁下记录命中，缓冲区满时尝试获取写锁批量回放
+            if (this->mode_ == myLruMode::Buffered)
+            {
+                bool shouldDrain = false;
+                {
+                    std::shared_lock<std::shared_mutex> lock(this->mutex_, std::defer_lock);
+                    if (!myAcquireLock<TRY>(lock))
+                    {
+                        return myTryStatus::Busy;
+                    }
+                    auto it = this->nodeMap_.find(key);
+                    if (it == nodeMap_.end() || this->isExpired(it->second))
+                    {
+                        return myTryStatus::Miss;
+                    }
+                    NodePtr node = it->second;
+                    this->refresh_.onHit(node);
+                    visit(node);
+                    shouldDrain = this->readBuffer_->record(node, node->generation_);
+                }
+                if (shouldDrain)
+                {
+                    std::unique_lock<std::shared_mutex> lock(this->mutex_, std::try_to_lock);
+                    if (lock.owns_lock())
+                    {
+                        this->drainReadBuffer();
+                        this->expireEntries();
+                    }
+                }
+                return myTryStatus::Hit;
+            }
+
+            // 添加锁，避免竞争
+            std::unique_lock<std::shared_mutex> lock(this->mutex_, std::defer_lock);
+            if (!myAcquireLock<TRY>(lock))
+            {
+                return myTryStatus::Busy;
+            }
+            this->expireEntries();
+            return this->visitLocked(key, visit) ? myTryStatus::Hit : myTryStatus::Miss;
+        }
+
+        // 如果key已经在缓存中(且未过期)则更新value并返回 Hit，不存在时返回 Miss 且不会移动value；
+        // TRY 为 true 时写锁被占用直接返回 Busy
+        template <bool TRY = false, typename K, typename V>
+        myTryStatus updateIfExists(const K &key, V &&value, uint64_t expireTick = 0)
+        {
+            std::unique_lock<std::shared_mutex> lock(this->mutex_, std::defer_lock);
+            if (!myAcquireLock<TRY>(lock))
+            {
+                return myTryStatus::Busy;
+            }
+            this->drainReadBuffer();
+            this->expireEntries();
+            auto it = this->nodeMap_.find(key);
+            if (it == nodeMap_.end() || this->isExpired(it->second))
+            {
+                return myTryStatus::Miss;
+            }
+            updataLruNode(it->second, std::forward<V>(value), expireTick);
+            return myTryStatus::Hit;
+        }
+
+        // 写回后台刷新的结果：结点仍处于已认领状态(刷新期间没有被重新写入、移出或过期)时才更新
+        void refreshIfPending(const KEY &key, VALUE &&value, uint64_t expireTick)
+        {
+            std::lock_guard<std::shared_mutex> lock(this->mutex_);
+            this->drainReadBuffer();
+            this->expireEntries();
+            auto it = this->nodeMap_.find(key);
+            if (it == nodeMap_.end() || this->isExpired(it->second) || it->second->getRefreshTick() != 0)
+            {
+                return;
+            }
+            updataLruNode(it->second, std::move(value), expireTick);
+        }
+
+        // 结点是否已经过期(读锁下即可判断，过期结点由写操作回收)
+        bool isExpired(NodePtr node) const
+        {
+            return node->hasExpiry() && node->isExpired(myTimingWheelNow());
+        }
+
     private:
         /*
             私有成员函数方法
@@ -169,19 +583,150 @@ namespace myCacheSystem
         // 链表节点初始化
         void lruNodeListInit()
         {
-            head_ = std::make_shared<LruNodeType>(KEY(), VALUE());
-            tail_ = std::make_shared<LruNodeType>(KEY(), VALUE());
+            head_ = pool_.allocate();
+            tail_ = pool_.allocate();
             head_->next_ = tail_;
             tail_->prev_ = head_;
         }
 
-        // 更新节点的value
-        void updataLruNode(NodePtr node, const VALUE &value)
+        // 推进时间轮，回收最多 kExpireBudget 个过期结点(调用者持有写锁)
+        void expireEntries()
+        {
+            if (this->wheel_.empty())
+            {
+                return;
+            }
+            this->wheel_.expire(myTimingWheelNow(), kExpireBudget, [this](NodePtr node)
+                                { this->eraseNode(node); });
+        }
+
+        // 设置结点的过期刻度(0表示不过期)，开启刷新时同时记录刷新刻度
+        void setExpiry(NodePtr node, uint64_t expireTick)
         {
-            // 1. 更新值
-            node->setValue(value);
-            // 2. 将该节点移动至末尾
-            removeToRecent(node);
+            node->setRefreshTick(this->refresh_.deadline());
+            if (expireTick != 0)
+            {
+                this->wheel_.schedule(node, expireTick);
+            }
+            else
+            {
+                this->wheel_.cancel(node);
+            }
+        }
+
+        // 从链表、哈希表和时间轮中删除结点并归还结点池
+        void eraseNode(NodePtr node)
+        {
+            this->removeNode(node);
+            this->nodeMap_.erase(node->key_);
+            this->totalWeight_ -= node->weight_;
+            this->wheel_.cancel(node);
+            this->releaseNode(node);
+        }
+
+        // 归还结点池；交出过句柄的结点等待所有句柄释放后再归还
+        void releaseNode(NodePtr node)
+        {
+            if (node->pinned_.load(std::memory_order_relaxed))
+            {
+                this->pinnedNodes_.retire(node);
+                return;
+            }
+            this->pool_.deallocate(node);
+        }
+
+        // 从结点池取出结点，先回收已经没有句柄引用的结点
+        NodePtr allocateNode()
+        {
+            this->pinnedNodes_.reclaim([this](NodePtr node)
+                                       {
+                node->pinned_.store(false, std::memory_order_relaxed);
+                this->pool_.deallocate(node); });
+            return this->pool_.allocate();
+        }
+
+        // 用新结点顶替交出过句柄的结点(链表位置、哈希表、过期时间和访问状态不变)，旧结点等待延迟回收
+        NodePtr replacePinnedNode(NodePtr old)
+        {
+            NodePtr node = this->allocateNode();
+            node->key_ = old->key_;
+            node->accessCount_ = old->accessCount_;
+            node->weight_ = old->weight_;
+            node->referenced_.store(old->referenced_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            ++node->generation_;
+            node->prev_ = old->prev_;
+            node->next_ = old->next_;
+            node->prev_->next_ = node;
+            node->next_->prev_ = node;
+            old->prev_ = nullptr;
+            old->next_ = nullptr;
+            this->nodeMap_.find(node->key_)->second = node;
+            if (old->hasExpiry())
+            {
+                this->wheel_.schedule(node, old->getExpireTick());
+            }
+            this->wheel_.cancel(old);
+            this->pinnedNodes_.retire(old);
+            return node;
+        }
+
+        // 回放读缓冲区中记录的命中(调用者持有写锁)
+        void drainReadBuffer()
+        {
+            if (!this->readBuffer_)
+            {
+                return;
+            }
+            this->readBuffer_->drain([this](NodePtr node, uint32_t generation)
+                                     {
+                // 结点已被淘汰或复用给其他key，丢弃这条记录
+                if (node->generation_ != generation || !node->prev_)
+                {
+                    return;
+                }
+                this->removeToRecent(node); });
+        }
+
+        // 计算缓存项权重
+        template <typename K, typename V>
+        size_t weigh(const K &key, const V &value) const
+        {
+            return this->weigher_ ? this->weigher_(key, value) : 1;
+        }
+
+        // 更新节点的value和过期时间
+        template <typename V>
+        void updataLruNode(NodePtr node, V &&value, uint64_t expireTick)
+        {
+            // 1. 更新值和权重，新值超过整个预算时直接移出缓存；交出过句柄的结点不能原地修改，先换成新结点
+            if (node->pinned_.load(std::memory_order_relaxed))
+            {
+                node = this->replacePinnedNode(node);
+            }
+            node->value_ = std::forward<V>(value);
+            size_t weight = this->weigh(node->key_, node->value_);
+            if (weight > this->capacity_)
+            {
+                this->eraseNode(node);
+                return;
+            }
+            this->totalWeight_ = this->totalWeight_ - node->weight_ + weight;
+            node->weight_ = weight;
+            this->setExpiry(node, expireTick);
+            // 2. 将该节点移动至末尾(CLOCK模式只设置访问位)
+            if (this->mode_ == myLruMode::Clock)
+            {
+                node->referenced_.store(true, std::memory_order_relaxed);
+            }
+            else
+            {
+                removeToRecent(node);
+            }
+            // 3. 权重变大后可能超出预算，淘汰其他结点
+            while (this->totalWeight_ > this->capacity_)
+            {
+                removeLruNode();
+            }
         }
 
         // 移动到链表末尾
@@ -194,20 +739,19 @@ namespace myCacheSystem
         // 移除节点
         void removeNode(NodePtr node)
         {
-            if (!node->prev_.expired() && node->next_)
+            if (node->prev_ && node->next_)
             {
-                auto prev = node->prev_.lock(); // 获取shared_ptr
-                prev->next_ = node->next_;      // 更新前一个节点的next指针
-                node->next_->prev_ = prev;      // 更新后一个节点的prev指针
-                node->next_ = nullptr;          // 清空next_指针，彻底断开节点与链表的连接,prev_
-                                                // 是 weak_ptr，不需要手动重置
+                node->prev_->next_ = node->next_; // 更新前一个节点的next指针
+                node->next_->prev_ = node->prev_; // 更新后一个节点的prev指针
+                node->prev_ = nullptr;            // 清空指针，彻底断开节点与链表的连接
+                node->next_ = nullptr;
             }
         }
 
         // 再末尾插入节点
         void insertNode(NodePtr node)
         {
-            auto prev = this->tail_->prev_.lock(); // 获取尾节点上一结点，即最后一个有效节点
+            NodePtr prev = this->tail_->prev_; // 获取尾节点上一结点，即最后一个有效节点
             prev->next_ = node;
             node->next_ = this->tail_;
             this->tail_->prev_ = node;
@@ -215,35 +759,72 @@ namespace myCacheSystem
         }
 
         // 增加结点
-        void addLruNode(const KEY &key, const VALUE &value)
+        template <typename K, typename V>
+        void addLruNode(K &&key, V &&value, uint64_t expireTick)
         {
-            // 判断容量，如果大于等于缓存区，则移除最近最久未使用的结点
-            if (this->nodeMap_.size() >= this->capacity_)
+            // 超过整个预算的缓存项不缓存
+            size_t weight = this->weigh(key, value);
+            if (weight > this->capacity_)
+            {
+                return;
+            }
+            // 移除最近最久未使用的结点，直到放得下新结点
+            while (this->totalWeight_ + weight > this->capacity_ && this->head_->next_ != this->tail_)
             {
                 removeLruNode();
             }
-            NodePtr newNode = std::make_shared<LruNodeType>(key, value); // 构建新结点
-            insertNode(newNode);                                         // 插入末尾
-            this->nodeMap_[key] = newNode;                               // 更新哈希表
+            NodePtr newNode = this->allocateNode(); // 从结点池取出结点(复用被淘汰的结点)
+            newNode->key_ = key;
+            newNode->value_ = std::forward<V>(value);
+            newNode->accessCount_ = 1;
+            newNode->weight_ = weight;
+            this->totalWeight_ += weight;
+            this->setExpiry(newNode, expireTick);
+            newNode->referenced_.store(false, std::memory_order_relaxed);
+            ++newNode->generation_;
+            insertNode(newNode);                                   // 插入末尾
+            this->nodeMap_.emplace(std::forward<K>(key), newNode); // 更新哈希表
         }
 
         // 删除最近最少使用结点
         void removeLruNode()
         {
             NodePtr node = this->head_->next_;
-            this->removeNode(node);
-            this->nodeMap_.erase(node->getKey());
+            if (node == this->tail_)
+                return;
+            // CLOCK模式：访问位为1的结点清零并移到末尾，最多扫描一轮必然能找到淘汰结点
+            if (this->mode_ == myLruMode::Clock)
+            {
+                while (node->referenced_.load(std::memory_order_relaxed))
+                {
+                    node->referenced_.store(false, std::memory_order_relaxed);
+                    this->removeToRecent(node);
+                    node = this->head_->next_;
+                }
+            }
+            this->eraseNode(node);
         }
 
-        size_t capacity_;  // 缓存容量
-        NodeMap nodeMap_;  // 哈希表，便于快速查找节点
-        std::mutex mutex_; // 互斥锁
+        size_t capacity_;         // 缓存容量(设置权重函数时为权重预算)
+        size_t totalWeight_;      // 当前总权重
+        myLruMode mode_;          // 工作模式
+        Weigher weigher_;         // 权重函数，为空时每个结点权重为1
+        NodePool pool_;           // 结点池，预分配全部结点
+        NodeMap nodeMap_;         // 哈希表，便于快速查找节点
+        TimingWheel wheel_;       // 时间轮，管理设置了过期时间的结点
+        mutable std::shared_mutex mutex_; // 读写锁，CLOCK/Buffered模式的命中只需要读锁
+        std::unique_ptr<ReadBuffer> readBuffer_; // 读缓冲区，仅Buffered模式创建
+        PinnedNodes pinnedNodes_; // 交出过句柄、等待延迟回收的结点
         NodePtr head_;     // 虚拟头结点
         NodePtr tail_;     // 虚拟尾结点
+        RefreshAhead refresh_; // 写入后刷新，最先析构，等待进行中的刷新结束
     };
 
     /*
         myKLruCache
+        访问历史是固定内存的指纹计数表(myAccessHistory)，冷key和扫描流量不会让堆增长
+        默认不暂存未达到k次访问的值：读未命中只累计次数，达到k次的那次写入进入主缓存
+        retainValues 为 true 时，每个历史槽位额外暂存一个值，读达到k次时直接提升，暂存值的数量不超过历史槽位数
     */
     template <typename KEY, typename VALUE>
     class myKLruCache : public myLruCache<KEY, VALUE>
@@ -253,94 +834,133 @@ namespace myCacheSystem
             构造函数
         */
 
-        // 有参构造函数
-        myKLruCache(size_t capacity, size_t historyCapacity, size_t k)
-            : myLruCache<KEY, VALUE>(capacity), historyList_(std::make_unique<myLruCache<KEY, size_t>>(historyCapacity)), k_(k) {}
+        // 有参构造函数 weigher 只作用于主缓存，访问历史按条目计数
+        // retainValues: 是否在访问历史中暂存值
+        myKLruCache(size_t capacity, size_t historyCapacity, size_t k, myWeigher<KEY, VALUE> weigher = myWeigher<KEY, VALUE>(), bool retainValues = false)
+            : myLruCache<KEY, VALUE>(capacity, myLruMode::Strict, std::move(weigher)), k_(k), history_(historyCapacity)
+        {
+            if (retainValues)
+            {
+                historyValues_ = std::make_unique<HistoryValue[]>(history_.slots());
+            }
+        }
 
         /*
             成员函数接口
         */
-        virtual VALUE get(KEY key) override
+        virtual bool get(const KEY &key, VALUE &value) override
+        {
+            return getImpl(key, value);
+        }
+
+        virtual VALUE get(const KEY &key) override
         {
-            // 1. 先尝试从主缓存找
             VALUE value{};
-            bool inMainCache = myLruCache<KEY, VALUE>::get(key, value);
+            getImpl(key, value);
+            return value;
+        }
 
-            // 2. 如果数据在主缓存中，直接返回
-            if (inMainCache)
-            {
-                return value;
-            }
+        template <typename K, typename = std::enable_if_t<myIsTransparentKey_v<KEY, K>>>
+        bool get(const K &key, VALUE &value)
+        {
+            return getImpl(key, value);
+        }
 
-            // 3. 如果不在主缓存，获取并更新访问历史计数
-            size_t historyCount = historyList_->get(key);
-            historyCount++;
-            historyList_->put(key, historyCount);
+        template <typename K, typename = std::enable_if_t<myIsTransparentKey_v<KEY, K>>>
+        VALUE get(const K &key)
+        {
+            VALUE value{};
+            getImpl(key, value);
+            return value;
+        }
 
-            // 4. 如果数据不在主缓存，但访问次数达到了k次
-            if (historyCount >= this->k_)
-            {
-                // 判断是否有历史值
-                auto it = historyValueMap_.find(key);
-                if (it != historyValueMap_.end())
-                {
-                    // 获取历史值
-                    VALUE storedValue = it->second;
-                    // 从历史记录移除
-                    historyList_->remove(key);
-                    historyValueMap_.erase(it);
+        virtual void put(const KEY &key, const VALUE &value) override
+        {
+            putImpl(key, value);
+        }
 
-                    // 将其添加到主缓存
-                    myLruCache<KEY, VALUE>::put(key, storedValue);
+        virtual void put(KEY &&key, VALUE &&value) override
+        {
+            putImpl(std::move(key), std::move(value));
+        }
 
-                    return storedValue;
-                }
-                // 如果没有历史值，无法添加到缓存，返回默认值
-            }
+        // 带过期时间的缓存在访问历史中也记录过期刻度，提升到主缓存时沿用
+        virtual void put(const KEY &key, const VALUE &value, std::chrono::milliseconds ttl) override
+        {
+            putImpl(key, value, myTimingWheelDeadline(ttl));
+        }
 
-            return value;
+        virtual void put(KEY &&key, VALUE &&value, std::chrono::milliseconds ttl) override
+        {
+            putImpl(std::move(key), std::move(value), myTimingWheelDeadline(ttl));
         }
 
-        virtual void put(KEY key, VALUE value) override
+        // 非阻塞接口：主缓存和访问历史的锁都只尝试一次
+        virtual myTryStatus tryGet(const KEY &key, VALUE &value) override
         {
-            // 1. 如果已经在主缓存则更新value
-            VALUE isExistingValue{}; // 临时值
-            bool isMainCache = myLruCache<KEY, VALUE>::get(key, isExistingValue);
+            myTryStatus status = myLruCache<KEY, VALUE>::tryGet(key, value);
+            return status == myTryStatus::Miss ? tryGetFromHistory(key, value) : status;
+        }
 
-            if (isMainCache)
-            {
-                myLruCache<KEY, VALUE>::put(key, value);
-                return;
-            }
+        virtual bool tryPut(const KEY &key, const VALUE &value) override
+        {
+            return tryPutImpl(key, value, 0);
+        }
 
-            // 2. 如果不在主缓存，检查k+1后是否达到要求，k没有达到要求不添加到主缓存
-            size_t historyCount = historyList_->get(key);
-            historyCount++;
-            historyList_->put(key, historyCount); // 更新位置至队首
+        virtual bool tryPut(const KEY &key, const VALUE &value, std::chrono::milliseconds ttl) override
+        {
+            return tryPutImpl(key, value, myTimingWheelDeadline(ttl));
+        }
 
-            historyValueMap_[key] = value; // 更新value
+        // 批量查询：主缓存整批加一次锁，未命中的key再逐个检查访问历史
+        virtual size_t getMany(std::span<const KEY> keys, std::span<VALUE> values, std::vector<bool> &hits) override
+        {
+            hits.assign(keys.size(), false);
+            return getManyImpl(keys.size(), [](size_t i)
+                               { return i; }, keys, values, hits);
+        }
 
-            // 3. k+1达到要求，则添加到主缓存
-            if (historyCount >= k_)
+        size_t getMany(std::span<const KEY> keys, std::span<const size_t> indexes, std::span<VALUE> values, std::vector<bool> &hits)
+        {
+            return getManyImpl(indexes.size(), [&](size_t i)
+                               { return indexes[i]; }, keys, values, hits);
+        }
+
+        // 批量添加：主缓存中已存在的key整批加一次锁更新，其余key逐个走访问历史
+        virtual void putMany(std::span<const KEY> keys, std::span<const VALUE> values) override
+        {
+            putManyImpl(keys.size(), [](size_t i)
+                        { return i; }, keys, values);
+        }
+
+        void putMany(std::span<const KEY> keys, std::span<const size_t> indexes, std::span<const VALUE> values)
+        {
+            putManyImpl(indexes.size(), [&](size_t i)
+                        { return indexes[i]; }, keys, values);
+        }
+
+        void clear()
+        {
+            myLruCache<KEY, VALUE>::clear();
+            std::lock_guard<std::mutex> lock(historyMutex_);
+            history_.clear();
+            if (historyValues_)
             {
-                historyList_->remove(key);
-                historyValueMap_.erase(key);
-                myLruCache<KEY, VALUE>::put(key, value); // 添加到主缓存
+                std::fill_n(historyValues_.get(), history_.slots(), HistoryValue());
             }
         }
 
-        void clear()
+        // 访问历史占用的固定内存(字节，不含暂存值自身的堆内存)
+        size_t historyMemoryBytes() const
         {
-            historyList_->clear();
-            historyValueMap_.clear();
+            return history_.memoryBytes() + (historyValues_ ? history_.slots() * sizeof(HistoryValue) : 0);
         }
 
 #ifdef DEBUG
-        // 测试代码，打印历史缓存内容和缓存次数
+        // 测试代码，打印访问历史占用和主缓存内容
         virtual void printCache() override
         {
-            std::cout << "History Cache Contents (Key-Value pairs):" << std::endl;
-            historyList_->printCache();
+            std::cout << "History slots: " << history_.slots() << " bytes: " << historyMemoryBytes() << std::endl;
             // 打印主缓存内容
             std::cout << "Main Cache Contents:" << std::endl;
             myLruCache<KEY, VALUE>::printCache();
@@ -348,76 +968,241 @@ namespace myCacheSystem
 #endif
 
     private:
-        size_t k_;                                             // 进入缓存队列的评判标准
-        std::unique_ptr<myLruCache<KEY, size_t>> historyList_; // 访问数据历史记录(value为访问次数)
-        std::unordered_map<KEY, VALUE> historyValueMap_;       // 存储未达到k次访问的数据值
-    };
+        template <typename K>
+        bool getImpl(const K &key, VALUE &value)
+        {
+            // 1. 先尝试从主缓存找，在主缓存中直接返回
+            if (myLruCache<KEY, VALUE>::getImpl(key, value))
+            {
+                return true;
+            }
+            return getFromHistory(key, value);
+        }
 
-    /*
-        对LRUCache进行分片处理，避免高并发情况下，同步的时间等待
-    */
-    template <typename KEY, typename VALUE>
-    class myKHashLruCache
-    {
-        typedef std::unique_ptr<myKLruCache<KEY, VALUE>> myKLruCachePtr;
+        // 主缓存未命中：更新访问历史，达到k次且有暂存值时提升到主缓存
+        template <typename K>
+        bool getFromHistory(const K &key, VALUE &value)
+        {
+            std::unique_lock<std::mutex> lock(historyMutex_);
+            // 2. 如果不在主缓存，更新访问历史计数
+            size_t slot = 0;
+            uint32_t historyCount = history_.touch(key, slot);
+            if (historyValues_ && historyCount == 1)
+            {
+                // 新占用的槽位，丢弃上一个key暂存的值
+                historyValues_[slot] = HistoryValue();
+            }
+
+            // 3. 如果数据不在主缓存，但访问次数达到了k次，且暂存了这个key的值
+            if (historyCount < k_ || !historyValues_ || !historyValues_[slot].valid_ || !(historyValues_[slot].key_ == key))
+            {
+                return false;
+            }
+            HistoryValue stored = std::move(historyValues_[slot]);
+            historyValues_[slot] = HistoryValue();
+            history_.erase(slot);
+            lock.unlock();
+
+            // 暂存值已经过期，丢弃
+            if (stored.expireTick_ != 0 && stored.expireTick_ <= myTimingWheelNow())
+            {
+                return false;
+            }
+            // 将其添加到主缓存
+            value = stored.value_;
+            myLruCache<KEY, VALUE>::putImpl(std::move(stored.key_), std::move(stored.value_), stored.expireTick_);
+            return true;
+        }
 
-    public:
         /*
-            构造函数
+            getFromHistory 的非阻塞版本：访问历史的锁被占用时返回 Busy
+            需要提升到主缓存时，在持有访问历史锁的情况下尝试写入主缓存，主缓存的锁也被占用就不修改访问历史，返回 Busy
         */
-        myKHashLruCache(size_t capacity, size_t sliceNumber)
-            : capacity_(capacity), sliceNumber_(sliceNumber > 0 ? sliceNumber : std::thread::hardware_concurrency())
+        template <typename K>
+        myTryStatus tryGetFromHistory(const K &key, VALUE &value)
         {
-            // 构造sliceCache在堆区
-            // 获取每个分区的容量
-            size_t sliceSize = std::ceil(static_cast<double>(capacity_) / static_cast<double>(sliceNumber_));
-            // 循环构建每个分片
-            for (int i = 0; i < sliceSize; ++i)
+            std::unique_lock<std::mutex> lock(historyMutex_, std::try_to_lock);
+            if (!lock.owns_lock())
+            {
+                return myTryStatus::Busy;
+            }
+            size_t slot = 0;
+            uint32_t historyCount = historyValues_ ? history_.count(key, slot) : 0;
+            if (historyCount == 0 || historyCount + 1 < k_ || !historyValues_[slot].valid_ || !(historyValues_[slot].key_ == key))
+            {
+                // 不会提升：与阻塞版本相同地累计访问次数
+                if (history_.touch(key, slot) == 1 && historyValues_)
+                {
+                    historyValues_[slot] = HistoryValue();
+                }
+                return myTryStatus::Miss;
+            }
+            // 暂存值已经过期则丢弃，否则写入主缓存
+            HistoryValue &stored = historyValues_[slot];
+            bool expired = stored.expireTick_ != 0 && stored.expireTick_ <= myTimingWheelNow();
+            if (!expired)
             {
-                lruSliceCache_.emplace_back(std::make_unique<myLruCache<KEY, VALUE>>(sliceSize));
+                if (!myLruCache<KEY, VALUE>::template putImpl<true>(stored.key_, stored.value_, stored.expireTick_))
+                {
+                    return myTryStatus::Busy;
+                }
+                value = stored.value_;
             }
+            historyValues_[slot] = HistoryValue();
+            history_.erase(slot);
+            return expired ? myTryStatus::Miss : myTryStatus::Hit;
         }
 
-        /*
-            成员函数接口
-        */
-        void put(KEY key, VALUE value)
+        // putImpl 的非阻塞版本，提升到主缓存的处理与 tryGetFromHistory 相同
+        bool tryPutImpl(const KEY &key, const VALUE &value, uint64_t expireTick)
         {
-            size_t hashKey = hashFunction(key) % sliceNumber_;
-            lruSliceCache_[hashKey]->put(key, value);
+            myTryStatus status = myLruCache<KEY, VALUE>::template updateIfExists<true>(key, value, expireTick);
+            if (status != myTryStatus::Miss)
+            {
+                return status == myTryStatus::Hit;
+            }
+            std::unique_lock<std::mutex> lock(historyMutex_, std::try_to_lock);
+            if (!lock.owns_lock())
+            {
+                return false;
+            }
+            size_t slot = 0;
+            uint32_t historyCount = history_.count(key, slot);
+            if (historyCount + 1 >= k_)
+            {
+                // 这次写入达到k次：主缓存写入成功后才移出访问历史
+                if (!myLruCache<KEY, VALUE>::template putImpl<true>(key, value, expireTick))
+                {
+                    return false;
+                }
+                if (historyCount != 0)
+                {
+                    history_.erase(slot);
+                    if (historyValues_)
+                    {
+                        historyValues_[slot] = HistoryValue();
+                    }
+                }
+                return true;
+            }
+            history_.touch(key, slot);
+            if (historyValues_)
+            {
+                historyValues_[slot] = HistoryValue{key, value, expireTick, true};
+            }
+            return true;
         }
 
-        bool get(KEY key, VALUE &value)
+        template <typename K, typename V>
+        void putImpl(K &&key, V &&value, uint64_t expireTick = 0)
         {
-            size_t hashKey = hashFunction(key) % sliceNumber_;
-            return lruSliceCache_[hashKey]->get(key, value);
+            // 1. 如果已经在主缓存则更新value(不存在时value不会被移动)
+            if (myLruCache<KEY, VALUE>::updateIfExists(key, std::forward<V>(value), expireTick) == myTryStatus::Hit)
+            {
+                return;
+            }
+            putToHistory(std::forward<K>(key), std::forward<V>(value), expireTick);
         }
 
-        VALUE get(KEY key)
+        // 不在主缓存：累计访问次数，达到k次才进入主缓存
+        template <typename K, typename V>
+        void putToHistory(K &&key, V &&value, uint64_t expireTick = 0)
         {
-            VALUE value{};
-            get(key, value);
-            return value;
+            {
+                std::lock_guard<std::mutex> lock(historyMutex_);
+                // 2. 如果不在主缓存，累计访问次数
+                size_t slot = 0;
+                uint32_t historyCount = history_.touch(key, slot);
+
+                // 3. k次以下不添加到主缓存，配置了暂存时记录value和过期刻度
+                if (historyCount < k_)
+                {
+                    if (historyValues_)
+                    {
+                        historyValues_[slot] = HistoryValue{KEY(key), VALUE(std::forward<V>(value)), expireTick, true};
+                    }
+                    return;
+                }
+                // 4. 达到要求，移出访问历史
+                history_.erase(slot);
+                if (historyValues_)
+                {
+                    historyValues_[slot] = HistoryValue();
+                }
+            }
+            myLruCache<KEY, VALUE>::putImpl(std::forward<K>(key), std::forward<V>(value), expireTick);
         }
 
-        void clear()
+        template <typename INDEX>
+        size_t getManyImpl(size_t count, INDEX &&indexAt, std::span<const KEY> keys, std::span<VALUE> values, std::vector<bool> &hits)
         {
-            for (auto &lruSliceItem : lruSliceCache_)
+            size_t hitCount = myLruCache<KEY, VALUE>::getManyImpl(count, indexAt, keys, values, hits);
+            for (size_t i = 0; i < count; ++i)
             {
-                lruSliceItem->clear();
+                size_t index = indexAt(i);
+                if (!hits[index] && getFromHistory(keys[index], values[index]))
+                {
+                    hits[index] = true;
+                    ++hitCount;
+                }
             }
+            return hitCount;
         }
 
-    private:
-        size_t hashFunction(KEY key)
+        template <typename INDEX>
+        void putManyImpl(size_t count, INDEX &&indexAt, std::span<const KEY> keys, std::span<const VALUE> values)
         {
-            std::hash<KEY> hashFunc;
-            return hashFunc(key);
+            std::vector<bool> updated(keys.size(), false);
+            myLruCache<KEY, VALUE>::updateManyIfExists(count, indexAt, keys, values, updated);
+            for (size_t i = 0; i < count; ++i)
+            {
+                size_t index = indexAt(i);
+                if (!updated[index])
+                {
+                    putToHistory(keys[index], values[index]);
+                }
+            }
         }
 
-        size_t capacity_;                           // LruCache总容量
-        size_t sliceNumber_;                        // 分片数量
-        std::vector<myKLruCachePtr> lruSliceCache_; // 存储LruCache的容器
+        // 访问历史中暂存的值，按槽位存放；槽位被其他key占用后整体清空
+        struct HistoryValue
+        {
+            KEY key_{};
+            VALUE value_{};
+            uint64_t expireTick_ = 0; // 过期刻度，0表示不过期
+            bool valid_ = false;
+        };
+
+        size_t k_;                                        // 进入缓存队列的评判标准
+        myAccessHistory<KEY> history_;                    // 访问历史(固定内存的指纹计数表)
+        std::unique_ptr<HistoryValue[]> historyValues_;   // 与历史槽位一一对应的暂存值，未开启时为空
+        std::mutex historyMutex_;                         // 保护访问历史和暂存值
+    };
+
+    /*
+        对LRUCache进行分片处理，避免高并发情况下，同步的时间等待
+        每个分片是一个独立加锁的 myKLruCache，分片规则见 myShardedCache
+    */
+    template <typename KEY, typename VALUE>
+    class myKHashLruCache : public myShardedCache<KEY, VALUE, myKLruCache<KEY, VALUE>>
+    {
+        typedef myShardedCache<KEY, VALUE, myKLruCache<KEY, VALUE>> Base;
+
+    public:
+        /*
+            构造函数
+        */
+        // historyCapacity: 访问历史的总容量(0表示与capacity相同) k: 进入主缓存需要的访问次数
+        // weigher: 非空时 capacity 为总权重预算，按分片平均分配；此时 historyCapacity 仍是条目数，需要显式给出
+        // retainValues: 访问历史是否暂存值，见 myKLruCache
+        myKHashLruCache(size_t capacity, size_t sliceNumber, size_t historyCapacity = 0, size_t k = 2, myWeigher<KEY, VALUE> weigher = myWeigher<KEY, VALUE>(), bool retainValues = false)
+            : Base(capacity, sliceNumber, [&](size_t sliceSize, size_t sliceNum)
+                   {
+                       size_t history = historyCapacity > 0 ? historyCapacity : capacity;
+                       size_t sliceHistory = std::ceil(static_cast<double>(history) / static_cast<double>(sliceNum));
+                       return std::make_unique<typename Base::Slice>(sliceSize, sliceHistory, k, weigher, retainValues); })
+        {
+        }
     };
 
 } // namespace myCacheSystem
@@ -0,0 +1,95 @@
+#ifndef MYNODEPOOL_H
+#define MYNODEPOOL_H
+
+#include <memory>
+#include <vector>
+#include <algorithm>
+
+namespace myCacheSystem
+{
+    /*
+        结点内存池(slab)
+        1. 结点按slab批量预分配，结点地址在内存池生命周期内保持不变，链表可以直接使用裸指针链接
+        2. 释放的结点压入空闲栈，下次分配直接复用，稳态下put/get不会触发堆分配，也没有引用计数的原子操作
+        3. 空闲结点耗尽时追加新的slab，已分配的结点不会移动
+        4. 结点提供 releasePayload() 时，归还时先释放键值，淘汰、删除、过期和清空的键值不会留在空闲栈中
+        NODE 需要可默认构造，复用时由调用者重新设置键值
+    */
+    template <typename NODE>
+    class myNodePool
+    {
+    public:
+        /*
+            构造函数
+        */
+        // capacity: 预分配的结点数量 growSize: 之后每次扩容的结点数量(0表示自动选择)
+        explicit myNodePool(size_t capacity, size_t growSize = 0)
+            : capacity_(0), growSize_(growSize)
+        {
+            if (capacity > 0)
+            {
+                addSlab(capacity);
+            }
+        }
+
+        myNodePool(const myNodePool &) = delete;
+        myNodePool &operator=(const myNodePool &) = delete;
+
+        /*
+            成员函数接口
+        */
+        // 分配一个结点
+        NODE *allocate()
+        {
+            if (freeList_.empty())
+            {
+                // 自动扩容：至少64个，或当前容量的一半
+                addSlab(growSize_ > 0 ? growSize_ : std::max<size_t>(64, capacity_ / 2));
+            }
+            NODE *node = freeList_.back();
+            freeList_.pop_back();
+            return node;
+        }
+
+        // 归还结点
+        void deallocate(NODE *node)
+        {
+            if (node)
+            {
+                if constexpr (requires { node->releasePayload(); })
+                {
+                    node->releasePayload();
+                }
+                freeList_.push_back(node);
+            }
+        }
+
+        // 结点总数
+        size_t capacity() const { return capacity_; }
+
+        // 正在使用的结点数
+        size_t inUse() const { return capacity_ - freeList_.size(); }
+
+    private:
+        // 追加一个slab，并把其中的结点全部压入空闲栈
+        void addSlab(size_t count)
+        {
+            std::unique_ptr<NODE[]> slab(new NODE[count]);
+            freeList_.reserve(capacity_ + count);
+            // 逆序压栈，使得先分配的结点地址连续递增
+            for (size_t i = count; i > 0; --i)
+            {
+                freeList_.push_back(&slab[i - 1]);
+            }
+            slabs_.emplace_back(std::move(slab));
+            capacity_ += count;
+        }
+
+        size_t capacity_;                           // 结点总数
+        size_t growSize_;                           // 扩容步长
+        std::vector<std::unique_ptr<NODE[]>> slabs_; // slab 列表
+        std::vector<NODE *> freeList_;              // 空闲结点栈
+    };
+} // namespace myCacheSystem
+
+#endif // MYNODEPOOL_H
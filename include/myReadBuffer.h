@@ -0,0 +1,129 @@
+#ifndef MYREADBUFFER_H
+#define MYREADBUFFER_H
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <functional>
+#include <cstdint>
+#include <algorithm>
+
+namespace myCacheSystem
+{
+    /*
+        命中记录缓冲区(Caffeine风格的read buffer)
+        1. 读操作命中后只把 (结点, 结点代数) 写入当前线程所在条带的环形缓冲区，写入是无锁的，
+           条带已满或者CAS竞争失败时直接丢弃这次记录(提升是近似的，允许丢失)
+        2. 持有写锁的线程调用 drain 批量回放记录，统一调整链表，锁持有时间和 head_/tail_
+           所在缓存行的跨核争用都被摊薄
+        3. 结点在记录和回放之间可能已经被淘汰或复用，回放时由调用者用结点代数校验
+        约束：drain 必须在写锁下调用(同一时间只有一个消费者)
+    */
+    template <typename NODE>
+    class myReadBuffer
+    {
+    public:
+        static constexpr size_t kSlotNumber = 16; // 每个条带的槽位数(2的幂)
+
+        /*
+            构造函数
+        */
+        // 条带数取不小于CPU核数的2的幂
+        myReadBuffer()
+        {
+            size_t cores = std::max(1u, std::thread::hardware_concurrency());
+            stripeNumber_ = 1;
+            while (stripeNumber_ < cores)
+            {
+                stripeNumber_ <<= 1;
+            }
+            stripes_ = std::make_unique<Stripe[]>(stripeNumber_);
+        }
+
+        myReadBuffer(const myReadBuffer &) = delete;
+        myReadBuffer &operator=(const myReadBuffer &) = delete;
+
+        /*
+            成员函数接口
+        */
+        // 记录一次命中，返回true表示条带已满，调用者应尽快drain
+        bool record(NODE *node, uint32_t generation)
+        {
+            Stripe &stripe = stripes_[probe() & (stripeNumber_ - 1)];
+            uint64_t tail = stripe.writeCount_.load(std::memory_order_relaxed);
+            uint64_t head = stripe.readCount_.load(std::memory_order_acquire);
+            if (tail - head >= kSlotNumber)
+            {
+                return true; // 已满，丢弃
+            }
+            if (!stripe.writeCount_.compare_exchange_strong(tail, tail + 1, std::memory_order_relaxed))
+            {
+                return false; // 竞争失败，丢弃
+            }
+            Slot &slot = stripe.slots_[tail & (kSlotNumber - 1)];
+            slot.generation_.store(generation, std::memory_order_relaxed);
+            slot.node_.store(node, std::memory_order_release);
+            return tail + 1 - head >= kSlotNumber;
+        }
+
+        // 回放全部记录(必须持有写锁)
+        template <typename FUNC>
+        void drain(FUNC &&func)
+        {
+            for (size_t i = 0; i < stripeNumber_; ++i)
+            {
+                Stripe &stripe = stripes_[i];
+                uint64_t head = stripe.readCount_.load(std::memory_order_relaxed);
+                uint64_t tail = stripe.writeCount_.load(std::memory_order_acquire);
+                while (head != tail)
+                {
+                    Slot &slot = stripe.slots_[head & (kSlotNumber - 1)];
+                    NODE *node = slot.node_.load(std::memory_order_acquire);
+                    if (!node)
+                    {
+                        break; // 槽位已被占用但还没有写入，下次再回放
+                    }
+                    uint32_t generation = slot.generation_.load(std::memory_order_relaxed);
+                    slot.node_.store(nullptr, std::memory_order_relaxed);
+                    func(node, generation);
+                    ++head;
+                }
+                stripe.readCount_.store(head, std::memory_order_release);
+            }
+        }
+
+    private:
+        struct Slot
+        {
+            std::atomic<NODE *> node_{nullptr};
+            std::atomic<uint32_t> generation_{0};
+        };
+
+        // 条带按缓存行对齐，避免不同线程的计数器伪共享
+        struct alignas(64) Stripe
+        {
+            std::atomic<uint64_t> writeCount_{0}; // 生产者写入位置
+            std::atomic<uint64_t> readCount_{0};  // 消费者回放位置
+            Slot slots_[kSlotNumber];
+        };
+
+        // 每个线程固定映射到一个条带
+        static size_t probe()
+        {
+            static thread_local size_t threadProbe = []()
+            {
+                size_t h = std::hash<std::thread::id>{}(std::this_thread::get_id());
+                h ^= h >> 33;
+                h *= 0xff51afd7ed558ccdULL;
+                h ^= h >> 33;
+                return h;
+            }();
+            return threadProbe;
+        }
+
+        size_t stripeNumber_;               // 条带数
+        std::unique_ptr<Stripe[]> stripes_; // 条带数组
+    };
+} // namespace myCacheSystem
+
+#endif // MYREADBUFFER_H
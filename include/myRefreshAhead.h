@@ -0,0 +1,201 @@
+#ifndef MYREFRESHAHEAD_H
+#define MYREFRESHAHEAD_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include "myExecutor.h"
+#include "myTimingWheel.h"
+
+namespace myCacheSystem
+{
+    /*
+        同时进行的刷新数量上限，分片缓存的所有分片共用一个，提交到同一个 executor 的刷新总数有界
+        先用 fetch_add 占用名额再判断，超出上限时立即归还，并发的读者不会一起越过上限
+    */
+    class myRefreshBudget
+    {
+    public:
+        static constexpr size_t kDefaultLimit = 1024;
+
+        /*
+            构造函数
+        */
+        explicit myRefreshBudget(size_t limit = kDefaultLimit) : limit_(limit), inFlight_(0) {}
+
+        myRefreshBudget(const myRefreshBudget &) = delete;
+        myRefreshBudget &operator=(const myRefreshBudget &) = delete;
+
+        /*
+            成员函数接口
+        */
+        // 占用一个名额，已经达到上限时返回 false
+        bool tryAcquire()
+        {
+            if (inFlight_.fetch_add(1, std::memory_order_relaxed) >= limit_)
+            {
+                inFlight_.fetch_sub(1, std::memory_order_relaxed);
+                return false;
+            }
+            return true;
+        }
+
+        void release()
+        {
+            inFlight_.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        // 占用中的名额
+        size_t inFlight() const
+        {
+            return inFlight_.load(std::memory_order_relaxed);
+        }
+
+        size_t limit() const { return limit_; }
+
+    private:
+        size_t limit_;                 // 名额上限
+        std::atomic<size_t> inFlight_; // 占用中的名额
+    };
+
+    /*
+        写入后刷新(refresh-ahead)
+        1. 开启后缓存每次写入都在结点上记录刷新刻度 = 写入时刻 + refreshAfter(myTimerNode::refreshTick_)
+        2. 命中一个过了刷新刻度、还没有过期的结点时，照常返回旧值，同时认领这次刷新(刷新刻度换成0，只有一个读者能认领)，
+           在 executor 上执行一次 loader，结果按原来的 ttl 写回；热点key在过期之前就被重新加载，不会在过期时出现同步回源
+        3. 刷新结果只在结点仍处于"已认领"状态时写回：刷新期间被重新写入、移出或过期的结点丢弃刷新结果
+        4. 同时进行的刷新不超过 myRefreshBudget 的上限(默认每个缓存 kMaxPending 个，分片缓存的各分片共用一个)，超出时本次命中不认领，留给之后的命中；loader 抛出异常时保留旧值，到期后按未命中处理
+        onHit 由缓存在持有读锁或写锁时调用；析构时等待已提交的刷新全部结束，应当作为缓存最后一个成员，最先析构
+    */
+    template <typename KEY, typename VALUE>
+    class myRefreshAhead
+    {
+    public:
+        using Loader = std::function<VALUE(const KEY &)>;
+        // 把刷新结果写回缓存(结点不再处于已认领状态时丢弃)
+        using Store = std::function<void(const KEY &, VALUE &&, uint64_t expireTick)>;
+
+        static constexpr size_t kMaxPending = myRefreshBudget::kDefaultLimit; // 默认的同时进行的刷新上限
+
+        /*
+            构造函数
+        */
+        myRefreshAhead() : refreshAfter_(0), executor_(nullptr), pending_(0) {}
+
+        myRefreshAhead(const myRefreshAhead &) = delete;
+        myRefreshAhead &operator=(const myRefreshAhead &) = delete;
+
+        ~myRefreshAhead()
+        {
+            wait();
+        }
+
+        /*
+            成员函数接口
+        */
+        // 开启刷新，需要在缓存开始读写之前调用(调用者持有缓存的写锁)；budget 为空时使用单独的 kMaxPending 上限
+        void enable(std::chrono::milliseconds refreshAfter, Loader loader, Store store, myExecutor &executor,
+                    std::shared_ptr<myRefreshBudget> budget = nullptr)
+        {
+            refreshAfter_ = static_cast<uint64_t>(std::max<int64_t>(refreshAfter.count(), 0));
+            loader_ = std::move(loader);
+            store_ = std::move(store);
+            executor_ = &executor;
+            budget_ = budget ? std::move(budget) : std::make_shared<myRefreshBudget>(kMaxPending);
+        }
+
+        bool enabled() const
+        {
+            return static_cast<bool>(loader_);
+        }
+
+        // 写入时的刷新刻度，未开启时为0
+        uint64_t deadline() const
+        {
+            return loader_ ? myTimingWheelDeadline(std::chrono::milliseconds(refreshAfter_)) : 0;
+        }
+
+        // 命中未过期的结点(调用者持有缓存的读锁或写锁)
+        template <typename NODE>
+        void onHit(NODE *node)
+        {
+            uint64_t refreshTick = node->getRefreshTick();
+            if (refreshTick == 0 || refreshTick > myTimingWheelNow())
+            {
+                return;
+            }
+            // 先占用名额再认领，认领失败时归还名额
+            if (!budget_->tryAcquire())
+            {
+                return;
+            }
+            if (!node->claimRefresh(refreshTick))
+            {
+                budget_->release();
+                return;
+            }
+            // 按写入时的 ttl 写回刷新结果，0表示不过期
+            uint64_t ttl = 0;
+            if (node->hasExpiry())
+            {
+                uint64_t writeTick = refreshTick - refreshAfter_;
+                ttl = node->getExpireTick() > writeTick ? node->getExpireTick() - writeTick : 1;
+            }
+            pending_.fetch_add(1, std::memory_order_relaxed);
+            executor_->post([this, key = node->getKey(), ttl]()
+                            {
+                try
+                {
+                    VALUE value = loader_(key);
+                    store_(key, std::move(value), ttl != 0 ? myTimingWheelDeadline(std::chrono::milliseconds(ttl)) : 0);
+                }
+                catch (...)
+                {
+                    // 加载失败：保留旧值，到期后按未命中处理
+                }
+                finishOne(); });
+        }
+
+        // 正在进行的刷新数量
+        size_t pending() const
+        {
+            return pending_.load(std::memory_order_relaxed);
+        }
+
+        // 等待已提交的刷新全部结束
+        void wait()
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            idle_.wait(lock, [this]()
+                       { return pending_.load(std::memory_order_relaxed) == 0; });
+        }
+
+    private:
+        // 在锁内减少计数，等待者看到0之后不会再访问本对象
+        void finishOne()
+        {
+            budget_->release();
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (pending_.fetch_sub(1, std::memory_order_relaxed) == 1)
+            {
+                idle_.notify_all();
+            }
+        }
+
+        uint64_t refreshAfter_;          // 写入后多久开始刷新(毫秒)
+        Loader loader_;                  // 加载函数，为空表示未开启
+        Store store_;                    // 写回刷新结果
+        myExecutor *executor_;           // 执行刷新的线程池
+        std::shared_ptr<myRefreshBudget> budget_; // 同时进行的刷新上限
+        std::atomic<size_t> pending_;    // 正在进行的刷新数量
+        std::mutex mutex_;               // 配合 idle_ 等待刷新结束
+        std::condition_variable idle_;
+    };
+} // namespace myCacheSystem
+
+#endif // MYREFRESHAHEAD_H
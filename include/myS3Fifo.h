@@ -0,0 +1,660 @@
+#ifndef MYS3FIFO_H
+#define MYS3FIFO_H
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "myCachePolicy.h"
+#include "myNodePool.h"
+#include "myHash.h"
+#include "myGhostList.h"
+#include "myTimingWheel.h"
+#include "myValueHandle.h"
+
+namespace myCacheSystem
+{
+    // 前向声明
+    template <typename KEY, typename VALUE>
+    class myS3FifoCache;
+
+    // 结点所在的队列
+    enum class myS3FifoQueue : uint8_t
+    {
+        Small, // 小队列：新key
+        Main   // 主队列：在小队列中被再次访问过，或者命中幽灵队列的key
+    };
+
+    // S3-FIFO的缓存节点，继承时间轮钩子以支持过期时间
+    template <typename KEY, typename VALUE>
+    class myS3FifoNode : public myTimerNode
+    {
+        friend class myS3FifoCache<KEY, VALUE>;
+
+    public:
+        /*
+            构造函数
+        */
+        myS3FifoNode() : hash_(0), deadline_(0), seq_(0), freq_(0), queue_(myS3FifoQueue::Small) {}
+
+        /*
+            成员函数接口
+        */
+        KEY getKey() const
+        {
+            return key_;
+        }
+
+        VALUE getValue() const
+        {
+            return value_;
+        }
+
+        // 饱和访问计数(0~3)
+        uint8_t getFreq() const
+        {
+            return freq_.load(std::memory_order_relaxed);
+        }
+
+        // 释放键值，结点归还 myNodePool 时调用，空闲栈中的结点不再占用键值的内存
+        void releasePayload()
+        {
+            key_ = KEY();
+            value_ = VALUE();
+        }
+
+    private:
+        KEY key_;
+        VALUE value_;
+        uint64_t hash_;             // key的哈希值
+        uint64_t deadline_;         // 过期刻度，发布后不再修改，读者不加锁读取(时间轮的刻度只由写操作使用)
+        uint64_t seq_;              // 在所在环形队列中的序号
+        std::atomic<uint8_t> freq_; // 访问计数，读者并发更新(relaxed)
+        myS3FifoQueue queue_;       // 所在队列
+    };
+
+    /*
+        S3-FIFO 缓存
+        1. 新key进入小队列(默认容量的10%)，命中幽灵队列的key直接进入主队列
+        2. 小队列出队的结点访问计数大于 kPromoteFreq 时移入主队列，否则淘汰并把key记入幽灵队列
+        3. 主队列出队的结点访问计数大于0时计数减一重新入队(与CLOCK相同)，否则淘汰
+        4. 命中只把结点的2位饱和计数加一(relaxed原子操作)，不移动任何结点，也不加锁：
+           索引是开放寻址的结点指针表，只有写操作修改，读者在纪元临界区内查找，结点发布后不再修改，
+           更新value时换成新结点；摘下的结点和索引表等纪元前进两次后才复用或释放
+        小队列和主队列是存放结点指针的环形数组，大小固定为容量的两倍以上：插入和淘汰都只在两端操作，
+        过期或删除的结点立即从队列中摘下并进入回收，留下的空位在队头时直接跳过，环形数组满时原地整理
+        幽灵队列使用 myGhostList，只记录key的指纹，容量与主队列相同
+        写操作持有互斥锁，顺带回收过期结点
+    */
+    template <typename KEY, typename VALUE>
+    class myS3FifoCache : public myCachePolicy<KEY, VALUE>
+    {
+    public:
+        typedef myS3FifoNode<KEY, VALUE> S3FifoNodeType;
+        typedef S3FifoNodeType *NodePtr;
+        typedef myNodePool<S3FifoNodeType> NodePool;
+        typedef myGhostList<KEY> GhostList;
+        typedef myTimingWheel<S3FifoNodeType> TimingWheel;
+        typedef myPinnedNodes<S3FifoNodeType> RetiredNodes;
+
+        static constexpr size_t kExpireBudget = 16; // 每次写操作最多回收的过期结点数
+        static constexpr uint8_t kMaxFreq = 3;      // 访问计数上限
+        static constexpr uint8_t kPromoteFreq = 0;  // 小队列中访问计数超过该值的结点移入主队列
+
+        /*
+            构造函数
+        */
+        // smallRatio: 小队列占总容量的比例，至少1个结点
+        explicit myS3FifoCache(size_t capacity, double smallRatio = 0.1)
+            : capacity_(capacity),
+              smallCapacity_(std::clamp<size_t>(static_cast<size_t>(capacity * smallRatio), 1, std::max<size_t>(capacity, 1))),
+              pool_(capacity + 1),
+              ghost_(std::max<size_t>(capacity_ - std::min(capacity_, smallCapacity_), 1)),
+              index_(new IndexTable(std::bit_ceil(std::max<size_t>(capacity * 2, 16)))),
+              indexUsed_(0)
+        {
+            small_.init(capacity_);
+            main_.init(capacity_);
+        }
+
+        ~myS3FifoCache() override
+        {
+            delete index_.load(std::memory_order_relaxed);
+        }
+
+        /*
+            成员函数接口
+        */
+        // 添加缓存
+        virtual void put(const KEY &key, const VALUE &value) override
+        {
+            putImpl(key, value);
+        }
+
+        virtual void put(KEY &&key, VALUE &&value) override
+        {
+            putImpl(std::move(key), std::move(value));
+        }
+
+        // 添加带过期时间的缓存
+        virtual void put(const KEY &key, const VALUE &value, std::chrono::milliseconds ttl) override
+        {
+            putImpl(key, value, myTimingWheelDeadline(ttl));
+        }
+
+        virtual void put(KEY &&key, VALUE &&value, std::chrono::milliseconds ttl) override
+        {
+            putImpl(std::move(key), std::move(value), myTimingWheelDeadline(ttl));
+        }
+
+        // 获取value
+        virtual bool get(const KEY &key, VALUE &value) override
+        {
+            auto guard = retired_.pin();
+            return getImpl(key, value);
+        }
+
+        virtual VALUE get(const KEY &key) override
+        {
+            VALUE value{};
+            auto guard = retired_.pin();
+            getImpl(key, value);
+            return value;
+        }
+
+        // 透明查找：std::string 键可以直接用 std::string_view 查询
+        template <typename K, typename = std::enable_if_t<myIsTransparentKey_v<KEY, K>>>
+        bool get(const K &key, VALUE &value)
+        {
+            auto guard = retired_.pin();
+            return getImpl(key, value);
+        }
+
+        template <typename K, typename = std::enable_if_t<myIsTransparentKey_v<KEY, K>>>
+        VALUE get(const K &key)
+        {
+            VALUE value{};
+            auto guard = retired_.pin();
+            getImpl(key, value);
+            return value;
+        }
+
+        // 非阻塞接口：读不加锁，从不返回 Busy；写只尝试一次互斥锁
+        virtual myTryStatus tryGet(const KEY &key, VALUE &value) override
+        {
+            auto guard = retired_.pin();
+            return getImpl(key, value) ? myTryStatus::Hit : myTryStatus::Miss;
+        }
+
+        virtual bool tryPut(const KEY &key, const VALUE &value) override
+        {
+            return putImpl<true>(key, value);
+        }
+
+        virtual bool tryPut(const KEY &key, const VALUE &value, std::chrono::milliseconds ttl) override
+        {
+            return putImpl<true>(key, value, myTimingWheelDeadline(ttl));
+        }
+
+        // 批量查询：整批只进入一次纪元临界区
+        virtual size_t getMany(std::span<const KEY> keys, std::span<VALUE> values, std::vector<bool> &hits) override
+        {
+            hits.assign(keys.size(), false);
+            auto guard = retired_.pin();
+            size_t hitCount = 0;
+            for (size_t i = 0; i < keys.size(); ++i)
+            {
+                if (getImpl(keys[i], values[i]))
+                {
+                    hits[i] = true;
+                    ++hitCount;
+                }
+            }
+            return hitCount;
+        }
+
+        // 删除指定结点
+        template <typename K>
+        void remove(const K &key)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            NodePtr node = findNode(key, hashOf(key));
+            if (node)
+            {
+                eraseNode(node);
+            }
+        }
+
+        // 清空缓存和幽灵队列
+        void clear()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (Queue *queue : {&small_, &main_})
+            {
+                while (!queue->empty())
+                {
+                    NodePtr node = queue->pop();
+                    if (node)
+                    {
+                        releaseNode(node);
+                    }
+                }
+                queue->size_ = 0;
+            }
+            ghost_.clear();
+            // 没有读者时立即释放所有键值，不必等到结点池用完
+            recycleRetired();
+        }
+
+        // 缓存项数量
+        size_t size() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return small_.size_ + main_.size_;
+        }
+
+    private:
+        /*
+            存放结点指针的环形队列，大小为2的幂且不小于容量的两倍
+            摘下的结点留下空指针；队列满时按原有顺序原地整理，每次整理至少回收容量个空位，均摊 O(1)
+        */
+        struct Queue
+        {
+            std::vector<NodePtr> ring_; // 环形数组
+            uint64_t head_ = 0;         // 队头序号
+            uint64_t tail_ = 0;         // 队尾序号
+            size_t size_ = 0;           // 有效结点数(不含空位)
+
+            void init(size_t capacity)
+            {
+                ring_.assign(std::bit_ceil(std::max<size_t>(capacity, 1)) * 2, nullptr);
+            }
+
+            bool empty() const { return head_ == tail_; }
+
+            void push(NodePtr node)
+            {
+                if (tail_ - head_ == ring_.size())
+                {
+                    compact();
+                }
+                node->seq_ = tail_;
+                ring_[tail_++ & (ring_.size() - 1)] = node;
+            }
+
+            // 出队，队头是空位时返回空指针
+            NodePtr pop()
+            {
+                NodePtr &slot = ring_[head_++ & (ring_.size() - 1)];
+                NodePtr node = slot;
+                slot = nullptr;
+                return node;
+            }
+
+            // 从队列中间摘下结点，队头的空位立即跳过
+            void remove(NodePtr node)
+            {
+                ring_[node->seq_ & (ring_.size() - 1)] = nullptr;
+                while (head_ != tail_ && !ring_[head_ & (ring_.size() - 1)])
+                {
+                    ++head_;
+                }
+            }
+
+            // 新结点顶替旧结点的位置
+            void replace(NodePtr old, NodePtr node)
+            {
+                node->seq_ = old->seq_;
+                ring_[old->seq_ & (ring_.size() - 1)] = node;
+            }
+
+            // 去掉空位，有效结点按原有顺序前移
+            void compact()
+            {
+                uint64_t next = head_;
+                for (uint64_t seq = head_; seq != tail_; ++seq)
+                {
+                    NodePtr node = ring_[seq & (ring_.size() - 1)];
+                    if (node)
+                    {
+                        ring_[seq & (ring_.size() - 1)] = nullptr;
+                        ring_[next & (ring_.size() - 1)] = node;
+                        node->seq_ = next++;
+                    }
+                }
+                tail_ = next;
+            }
+        };
+
+        /*
+            索引表：线性探测的开放寻址表，槽位为结点指针，空指针表示空位，tombstone_ 表示删除标记
+            大小为容量两倍以上的2的幂，非空槽位(含删除标记)超过 3/4 时换成重建的新表，读者总能遇到空位结束探测
+        */
+        struct IndexTable
+        {
+            explicit IndexTable(size_t size)
+                : slots_(std::make_unique<std::atomic<NodePtr>[]>(size)), mask_(size - 1)
+            {
+            }
+
+            std::unique_ptr<std::atomic<NodePtr>[]> slots_; // 槽位
+            size_t mask_;                                   // 槽位数 - 1
+        };
+
+        /*
+            私有成员函数方法
+        */
+        // TRY 为 true 时锁被占用直接返回false
+        template <bool TRY = false, typename K, typename V>
+        bool putImpl(K &&key, V &&value, uint64_t expireTick = 0)
+        {
+            if (capacity_ <= 0)
+                return true;
+
+            std::unique_lock<std::mutex> lock(mutex_, std::defer_lock);
+            if (!myAcquireLock<TRY>(lock))
+            {
+                return false;
+            }
+            expireEntries();
+            uint64_t hash = hashOf(key);
+            NodePtr old = findNode(key, hash);
+            if (old)
+            {
+                // 已存在：发布过的结点不能原地修改，换成新结点(队列位置和访问计数不变)，按一次命中处理
+                NodePtr node = allocateNode();
+                node->key_ = old->key_;
+                node->hash_ = hash;
+                node->value_ = std::forward<V>(value);
+                node->freq_.store(old->freq_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                node->queue_ = old->queue_;
+                setExpiry(node, expireTick);
+                queueOf(old).replace(old, node);
+                slotOf(old).store(node, std::memory_order_release);
+                wheel_.cancel(old);
+                retired_.retire(old);
+                touch(node);
+                return true;
+            }
+
+            // 腾出空间后插入，命中幽灵队列的key进入主队列
+            while (small_.size_ + main_.size_ >= capacity_)
+            {
+                evict();
+            }
+            size_t ghostWeight = 0;
+            NodePtr node = allocateNode();
+            node->key_ = std::forward<K>(key);
+            node->hash_ = hash;
+            node->value_ = std::forward<V>(value);
+            node->freq_.store(0, std::memory_order_relaxed);
+            setExpiry(node, expireTick);
+            enqueue(node, ghost_.take(node->key_, ghostWeight) ? myS3FifoQueue::Main : myS3FifoQueue::Small);
+            insertIndex(node);
+            return true;
+        }
+
+        // 命中只增加访问计数并拷贝value(调用者在纪元临界区内或持有锁)
+        template <typename K>
+        bool getImpl(const K &key, VALUE &value)
+        {
+            NodePtr node = findNode(key, hashOf(key));
+            if (!node || isExpired(node))
+            {
+                return false;
+            }
+            touch(node);
+            value = node->value_;
+            return true;
+        }
+
+        template <typename K>
+        static uint64_t hashOf(const K &key)
+        {
+            return myHashMix(myKeyHash<KEY>{}(key));
+        }
+
+        // 在索引中查找结点，读者和写者共用
+        template <typename K>
+        NodePtr findNode(const K &key, uint64_t hash) const
+        {
+            IndexTable *table = index_.load(std::memory_order_acquire);
+            for (size_t i = hash & table->mask_;; i = (i + 1) & table->mask_)
+            {
+                NodePtr node = table->slots_[i].load(std::memory_order_acquire);
+                if (!node)
+                {
+                    return nullptr;
+                }
+                if (node != &tombstone_ && node->hash_ == hash && myKeyEqual{}(node->key_, key))
+                {
+                    return node;
+                }
+            }
+        }
+
+        // 结点所在的索引槽位(调用者持有锁)
+        std::atomic<NodePtr> &slotOf(NodePtr node)
+        {
+            IndexTable *table = index_.load(std::memory_order_relaxed);
+            for (size_t i = node->hash_ & table->mask_;; i = (i + 1) & table->mask_)
+            {
+                if (table->slots_[i].load(std::memory_order_relaxed) == node)
+                {
+                    return table->slots_[i];
+                }
+            }
+        }
+
+        // 把新结点发布到索引(调用者持有锁，key不在索引中)，可以复用删除标记
+        void insertIndex(NodePtr node)
+        {
+            IndexTable *table = index_.load(std::memory_order_relaxed);
+            if (indexUsed_ + 1 > table->mask_ + 1 - (table->mask_ + 1) / 4)
+            {
+                table = rebuildIndex();
+            }
+            for (size_t i = node->hash_ & table->mask_;; i = (i + 1) & table->mask_)
+            {
+                NodePtr slot = table->slots_[i].load(std::memory_order_relaxed);
+                if (!slot || slot == &tombstone_)
+                {
+                    indexUsed_ += slot ? 0 : 1;
+                    table->slots_[i].store(node, std::memory_order_release);
+                    return;
+                }
+            }
+        }
+
+        // 按有效结点重建一张同样大小的索引表并发布，旧表等读者离开后释放
+        IndexTable *rebuildIndex()
+        {
+            IndexTable *old = index_.load(std::memory_order_relaxed);
+            IndexTable *table = new IndexTable(old->mask_ + 1);
+            size_t used = 0;
+            for (size_t i = 0; i <= old->mask_; ++i)
+            {
+                NodePtr node = old->slots_[i].load(std::memory_order_relaxed);
+                if (!node || node == &tombstone_)
+                {
+                    continue;
+                }
+                size_t j = node->hash_ & table->mask_;
+                while (table->slots_[j].load(std::memory_order_relaxed))
+                {
+                    j = (j + 1) & table->mask_;
+                }
+                table->slots_[j].store(node, std::memory_order_relaxed);
+                ++used;
+            }
+            index_.store(table, std::memory_order_release);
+            indexUsed_ = used;
+            retired_.retireObject(old);
+            return table;
+        }
+
+        // 饱和加一，并发的加一可能丢失，只影响近似计数
+        static void touch(NodePtr node)
+        {
+            uint8_t freq = node->freq_.load(std::memory_order_relaxed);
+            if (freq < kMaxFreq)
+            {
+                node->freq_.store(freq + 1, std::memory_order_relaxed);
+            }
+        }
+
+        Queue &queueOf(NodePtr node)
+        {
+            return node->queue_ == myS3FifoQueue::Small ? small_ : main_;
+        }
+
+        void enqueue(NodePtr node, myS3FifoQueue queue)
+        {
+            node->queue_ = queue;
+            Queue &target = queueOf(node);
+            target.push(node);
+            ++target.size_;
+        }
+
+        // 小队列超过容量(或主队列为空)时淘汰小队列，否则淘汰主队列
+        void evict()
+        {
+            if (small_.size_ > smallCapacity_ || main_.size_ == 0)
+            {
+                evictSmall();
+            }
+            else
+            {
+                evictMain();
+            }
+        }
+
+        // 小队列出队：访问过的结点移入主队列，直到淘汰一个结点(key记入幽灵队列)
+        void evictSmall()
+        {
+            while (!small_.empty())
+            {
+                NodePtr node = small_.pop();
+                if (!node)
+                {
+                    continue;
+                }
+                --small_.size_;
+                if (node->freq_.load(std::memory_order_relaxed) > kPromoteFreq)
+                {
+                    node->freq_.store(0, std::memory_order_relaxed);
+                    enqueue(node, myS3FifoQueue::Main);
+                    continue;
+                }
+                ghost_.push(node->key_, 1);
+                releaseNode(node);
+                return;
+            }
+        }
+
+        // 主队列出队：访问计数大于0的结点减一后重新入队，直到淘汰一个结点
+        void evictMain()
+        {
+            while (!main_.empty())
+            {
+                NodePtr node = main_.pop();
+                if (!node)
+                {
+                    continue;
+                }
+                --main_.size_;
+                uint8_t freq = node->freq_.load(std::memory_order_relaxed);
+                if (freq > 0)
+                {
+                    node->freq_.store(freq - 1, std::memory_order_relaxed);
+                    enqueue(node, myS3FifoQueue::Main);
+                    continue;
+                }
+                releaseNode(node);
+                return;
+            }
+        }
+
+        // 已出队的结点：从索引和时间轮中删除，等读者离开后归还结点池
+        void releaseNode(NodePtr node)
+        {
+            slotOf(node).store(&tombstone_, std::memory_order_release);
+            wheel_.cancel(node);
+            retired_.retire(node);
+        }
+
+        // 仍在队列中的结点：先从队列中摘下再释放
+        void eraseNode(NodePtr node)
+        {
+            Queue &queue = queueOf(node);
+            queue.remove(node);
+            --queue.size_;
+            releaseNode(node);
+        }
+
+        // 空闲结点用完时先回收读者已经离开的结点，仍然没有再让结点池扩容
+        NodePtr allocateNode()
+        {
+            if (pool_.inUse() == pool_.capacity())
+            {
+                recycleRetired();
+            }
+            return pool_.allocate();
+        }
+
+        // 读者已经离开的结点归还结点池(归还时释放键值)
+        void recycleRetired()
+        {
+            retired_.reclaim([this](NodePtr node)
+                             { pool_.deallocate(node); });
+        }
+
+        // 结点是否已经过期(读者不加锁即可判断，过期结点由写操作回收)
+        static bool isExpired(NodePtr node)
+        {
+            return node->deadline_ != 0 && node->deadline_ <= myTimingWheelNow();
+        }
+
+        // 推进时间轮，回收最多 kExpireBudget 个过期结点(调用者持有锁)
+        void expireEntries()
+        {
+            if (wheel_.empty())
+            {
+                return;
+            }
+            wheel_.expire(myTimingWheelNow(), kExpireBudget, [this](NodePtr node)
+                          { eraseNode(node); });
+        }
+
+        // 设置结点的过期刻度，0表示不过期(结点发布之前调用)
+        void setExpiry(NodePtr node, uint64_t expireTick)
+        {
+            node->deadline_ = expireTick;
+            if (expireTick != 0)
+            {
+                wheel_.schedule(node, expireTick);
+            }
+            else
+            {
+                wheel_.cancel(node);
+            }
+        }
+
+        size_t capacity_;                  // 总容量
+        size_t smallCapacity_;             // 小队列容量
+        mutable std::mutex mutex_;         // 写操作互斥锁，读操作不加锁
+        NodePool pool_;                    // 结点池
+        TimingWheel wheel_;                // 时间轮，管理设置了过期时间的结点
+        Queue small_;                      // 小队列
+        Queue main_;                       // 主队列
+        GhostList ghost_;                  // 幽灵队列(只记录key的指纹)
+        std::atomic<IndexTable *> index_;  // 当前索引表
+        size_t indexUsed_;                 // 索引表中非空槽位数(含删除标记)
+        S3FifoNodeType tombstone_;         // 删除标记，只比较地址
+        RetiredNodes retired_;             // 纪元：摘下的结点和索引表等读者离开后再复用或释放
+    };
+} // namespace myCacheSystem
+
+#endif // MYS3FIFO_H
@@ -0,0 +1,262 @@
+#ifndef MYSHARDEDCACHE_H
+#define MYSHARDEDCACHE_H
+
+#include <memory>
+#include <vector>
+#include <thread>
+#include <cmath>
+#include <algorithm>
+#include <span>
+#include "myCachePolicy.h"
+#include "myHash.h"
+#include "myRefreshAhead.h"
+
+namespace myCacheSystem
+{
+    /*
+        分片缓存的公共实现
+        1. 分片数向上取2的幂，用掩码代替取模
+        2. key的哈希先经过 myHashMix 混淆再取高位选择分片，避免整数键(std::hash为恒等映射)集中到少数分片，
+           也不会与分片内部哈希表使用的低位相关
+        3. 每个分片按缓存行对齐单独分配，相邻分片的互斥锁不会伪共享
+        CACHE 需要提供 put/get(与 myCachePolicy 一致) 和 clear
+    */
+    template <typename KEY, typename VALUE, typename CACHE>
+    class myShardedCache : public myCachePolicy<KEY, VALUE>
+    {
+    public:
+        static constexpr size_t kCacheLineSize = 64;
+
+        /*
+            构造函数
+        */
+        // factory(每个分片的容量, 分片数量) 返回 SlicePtr，分片的构造参数由派生类决定
+        template <typename FACTORY>
+        myShardedCache(size_t capacity, size_t sliceNumber, FACTORY &&factory)
+            : capacity_(capacity), sliceNumber_(1), shift_(64)
+        {
+            // 分片数向上取2的幂
+            size_t wanted = sliceNumber > 0 ? sliceNumber : std::max(1u, std::thread::hardware_concurrency());
+            while (sliceNumber_ < wanted)
+            {
+                sliceNumber_ <<= 1;
+                --shift_;
+            }
+            // 计算每个分片capacity
+            size_t sliceSize = std::ceil(static_cast<double>(capacity_) / static_cast<double>(sliceNumber_));
+            for (size_t i = 0; i < sliceNumber_; ++i)
+            {
+                slices_.emplace_back(factory(sliceSize, sliceNumber_));
+            }
+        }
+
+        ~myShardedCache() override = default;
+
+        /*
+            成员函数接口
+        */
+        virtual void put(const KEY &key, const VALUE &value) override
+        {
+            sliceFor(key).put(key, value);
+        }
+
+        virtual void put(KEY &&key, VALUE &&value) override
+        {
+            sliceFor(key).put(std::move(key), std::move(value));
+        }
+
+        virtual void put(const KEY &key, const VALUE &value, std::chrono::milliseconds ttl) override
+        {
+            sliceFor(key).put(key, value, ttl);
+        }
+
+        virtual void put(KEY &&key, VALUE &&value, std::chrono::milliseconds ttl) override
+        {
+            sliceFor(key).put(std::move(key), std::move(value), ttl);
+        }
+
+        virtual bool get(const KEY &key, VALUE &value) override
+        {
+            return sliceFor(key).get(key, value);
+        }
+
+        virtual VALUE get(const KEY &key) override
+        {
+            VALUE value{};
+            sliceFor(key).get(key, value);
+            return value;
+        }
+
+        // 支持透明查找键(如 std::string_view)
+        template <typename K, typename = std::enable_if_t<myIsTransparentKey_v<KEY, K>>>
+        bool get(const K &key, VALUE &value)
+        {
+            return sliceFor(key).get(key, value);
+        }
+
+        template <typename K, typename = std::enable_if_t<myIsTransparentKey_v<KEY, K>>>
+        VALUE get(const K &key)
+        {
+            VALUE value{};
+            sliceFor(key).get(key, value);
+            return value;
+        }
+
+        // 开启写入后刷新(CACHE 需要提供 enableRefresh)，每个分片各自记录刷新刻度，同时进行的刷新数量由所有分片共用的 budget 限制
+        template <typename LOADER>
+        void enableRefresh(std::chrono::milliseconds refreshAfter, LOADER loader, myExecutor &executor = myExecutor::defaultExecutor(),
+                           std::shared_ptr<myRefreshBudget> budget = nullptr)
+        {
+            if (!budget)
+            {
+                budget = std::make_shared<myRefreshBudget>();
+            }
+            for (auto &slice : slices_)
+            {
+                slice->cache_.enableRefresh(refreshAfter, loader, executor, budget);
+            }
+        }
+
+        // 非阻塞接口，只尝试key所在分片的锁
+        virtual myTryStatus tryGet(const KEY &key, VALUE &value) override
+        {
+            return sliceFor(key).tryGet(key, value);
+        }
+
+        virtual bool tryPut(const KEY &key, const VALUE &value) override
+        {
+            return sliceFor(key).tryPut(key, value);
+        }
+
+        virtual bool tryPut(const KEY &key, const VALUE &value, std::chrono::milliseconds ttl) override
+        {
+            return sliceFor(key).tryPut(key, value, ttl);
+        }
+
+        // 零拷贝读取(CACHE 需要提供 getHandle)，见 myValueHandle
+        template <typename K>
+        auto getHandle(const K &key)
+        {
+            return sliceFor(key).getHandle(key);
+        }
+
+        /*
+            批量接口：先按分片对下标分组，每个分片整批只加一次锁
+            CACHE 需要提供按下标子集处理的 getMany(keys, indexes, values, hits) / putMany(keys, indexes, values)
+        */
+        virtual size_t getMany(std::span<const KEY> keys, std::span<VALUE> values, std::vector<bool> &hits) override
+        {
+            hits.assign(keys.size(), false);
+            std::vector<size_t> order;
+            std::vector<size_t> offsets;
+            groupBySlice(keys, order, offsets);
+
+            size_t hitCount = 0;
+            for (size_t i = 0; i < sliceNumber_; ++i)
+            {
+                if (offsets[i + 1] > offsets[i])
+                {
+                    std::span<const size_t> indexes(order.data() + offsets[i], offsets[i + 1] - offsets[i]);
+                    hitCount += slices_[i]->cache_.getMany(keys, indexes, values, hits);
+                }
+            }
+            return hitCount;
+        }
+
+        virtual void putMany(std::span<const KEY> keys, std::span<const VALUE> values) override
+        {
+            std::vector<size_t> order;
+            std::vector<size_t> offsets;
+            groupBySlice(keys, order, offsets);
+
+            for (size_t i = 0; i < sliceNumber_; ++i)
+            {
+                if (offsets[i + 1] > offsets[i])
+                {
+                    std::span<const size_t> indexes(order.data() + offsets[i], offsets[i + 1] - offsets[i]);
+                    slices_[i]->cache_.putMany(keys, indexes, values);
+                }
+            }
+        }
+
+        void clear()
+        {
+            for (auto &slice : slices_)
+            {
+                slice->cache_.clear();
+            }
+        }
+
+        // 分片数量
+        size_t sliceNumber() const { return sliceNumber_; }
+
+        // 所有分片的总权重(CACHE 需要提供 weight())
+        size_t weight() const
+        {
+            size_t total = 0;
+            for (const auto &slice : slices_)
+            {
+                total += slice->cache_.weight();
+            }
+            return total;
+        }
+
+    protected:
+        // 分片：按缓存行对齐，大小也是缓存行的整数倍
+        struct alignas(kCacheLineSize) Slice
+        {
+            template <typename... ARGS>
+            explicit Slice(ARGS &&...args) : cache_(std::forward<ARGS>(args)...) {}
+
+            CACHE cache_;
+        };
+        typedef std::unique_ptr<Slice> SlicePtr;
+
+        // 计算key所在分片的下标
+        template <typename K>
+        size_t sliceIndex(const K &key) const
+        {
+            if (sliceNumber_ == 1)
+            {
+                return 0;
+            }
+            myKeyHash<KEY> hashFunc;
+            return static_cast<size_t>(myHashMix(hashFunc(key)) >> shift_);
+        }
+
+        template <typename K>
+        CACHE &sliceFor(const K &key)
+        {
+            return slices_[sliceIndex(key)]->cache_;
+        }
+
+        // 计数排序：order 中属于分片i的下标位于 [offsets[i], offsets[i+1])，同一分片内保持原有顺序
+        void groupBySlice(std::span<const KEY> keys, std::vector<size_t> &order, std::vector<size_t> &offsets) const
+        {
+            std::vector<size_t> sliceOf(keys.size());
+            offsets.assign(sliceNumber_ + 1, 0);
+            for (size_t i = 0; i < keys.size(); ++i)
+            {
+                sliceOf[i] = sliceIndex(keys[i]);
+                ++offsets[sliceOf[i] + 1];
+            }
+            for (size_t i = 0; i < sliceNumber_; ++i)
+            {
+                offsets[i + 1] += offsets[i];
+            }
+            order.resize(keys.size());
+            std::vector<size_t> cursor(offsets.begin(), offsets.end() - 1);
+            for (size_t i = 0; i < keys.size(); ++i)
+            {
+                order[cursor[sliceOf[i]]++] = i;
+            }
+        }
+
+        size_t capacity_;              // 总容量
+        size_t sliceNumber_;           // 分片数量(2的幂)
+        unsigned shift_;               // 选择分片时哈希右移的位数
+        std::vector<SlicePtr> slices_; // 分片容器
+    };
+} // namespace myCacheSystem
+
+#endif // MYSHARDEDCACHE_H
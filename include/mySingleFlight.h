@@ -0,0 +1,175 @@
+#ifndef MYSINGLEFLIGHT_H
+#define MYSINGLEFLIGHT_H
+
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "myHash.h"
+#include "myFlatHashMap.h"
+#include "myExecutor.h"
+
+namespace myCacheSystem
+{
+    /*
+        合并同一个key的并发加载(single flight)
+        1. 第一个到达的调用者成为执行者，登记后在锁外执行加载；
+           同一个key后到达的调用者只登记一个等待回调，不会重复加载
+        2. 执行者先注销登记再把结果(或异常)交给所有等待回调：注销之后到达的调用者会成为新的执行者，
+           由调用者在加载函数里先检查一次缓存(此时结果已经写入缓存)，避免重复加载
+        3. run() 是阻塞接口：等待者在锁外等待 future，加载抛出的异常在执行者中重新抛出；
+           runAsync() 是回调接口：等待者登记后立即返回，执行者的加载提交到 executor 上执行，协程接口用它挂起而不占用线程
+        登记表按key的哈希分成 kStripeNumber 个条带，每个条带一把锁，各占一个缓存行；锁只在登记和注销时短暂持有
+    */
+    template <typename KEY, typename VALUE>
+    class mySingleFlight
+    {
+    public:
+        static constexpr size_t kStripeNumber = 16; // 登记表条带数(2的幂)
+
+        // 等待回调：成功时 value 非空，失败时 error 非空
+        using Waiter = std::function<void(const VALUE *value, std::exception_ptr error)>;
+
+        /*
+            构造函数
+        */
+        mySingleFlight()
+        {
+            stripes_ = std::make_unique<Stripe[]>(kStripeNumber);
+        }
+
+        mySingleFlight(const mySingleFlight &) = delete;
+        mySingleFlight &operator=(const mySingleFlight &) = delete;
+
+        /*
+            成员函数接口
+        */
+        // 同一个key同时只有一个调用者执行 load()，其余调用者等待并共享同一个结果或异常
+        template <typename LOAD>
+        VALUE run(const KEY &key, LOAD &&load)
+        {
+            Stripe &stripe = stripeFor(key);
+            std::future<VALUE> inFlight;
+            {
+                std::lock_guard<std::mutex> lock(stripe.mutex_);
+                auto it = stripe.calls_.find(key);
+                if (it != stripe.calls_.end())
+                {
+                    auto promise = std::make_shared<std::promise<VALUE>>();
+                    inFlight = promise->get_future();
+                    it->second.push_back([promise](const VALUE *value, std::exception_ptr error)
+                                         {
+                                             if (value)
+                                             {
+                                                 promise->set_value(*value);
+                                             }
+                                             else
+                                             {
+                                                 promise->set_exception(error);
+                                             } });
+                }
+                else
+                {
+                    stripe.calls_.emplace(key, std::vector<Waiter>());
+                }
+            }
+            // 已经有调用者在加载，在锁外等待
+            if (inFlight.valid())
+            {
+                return inFlight.get();
+            }
+
+            try
+            {
+                VALUE value = load();
+                finish(stripe, key, &value, nullptr);
+                return value;
+            }
+            catch (...)
+            {
+                finish(stripe, key, nullptr, std::current_exception());
+                throw;
+            }
+        }
+
+        // 登记 done 后立即返回；成为执行者时把 load() 提交到 executor 上执行，结果通过 done 交付
+        template <typename LOAD>
+        void runAsync(const KEY &key, LOAD &&load, Waiter done, myExecutor &executor)
+        {
+            Stripe &stripe = stripeFor(key);
+            {
+                std::lock_guard<std::mutex> lock(stripe.mutex_);
+                auto it = stripe.calls_.find(key);
+                if (it != stripe.calls_.end())
+                {
+                    it->second.push_back(std::move(done));
+                    return;
+                }
+                std::vector<Waiter> waiters;
+                waiters.push_back(std::move(done));
+                stripe.calls_.emplace(key, std::move(waiters));
+            }
+            executor.post([this, &stripe, key, load = std::forward<LOAD>(load)]() mutable
+                          {
+                              std::exception_ptr error;
+                              try
+                              {
+                                  VALUE value = load();
+                                  finish(stripe, key, &value, nullptr);
+                                  return;
+                              }
+                              catch (...)
+                              {
+                                  error = std::current_exception();
+                              }
+                              finish(stripe, key, nullptr, error); });
+        }
+
+        // 正在加载的key数量
+        size_t inFlight() const
+        {
+            size_t count = 0;
+            for (size_t i = 0; i < kStripeNumber; ++i)
+            {
+                std::lock_guard<std::mutex> lock(stripes_[i].mutex_);
+                count += stripes_[i].calls_.size();
+            }
+            return count;
+        }
+
+    private:
+        // 登记表条带
+        struct alignas(64) Stripe
+        {
+            mutable std::mutex mutex_;                          // 保护 calls_
+            myFlatHashMap<KEY, std::vector<Waiter>> calls_;     // 正在加载的key和它的等待回调
+        };
+
+        Stripe &stripeFor(const KEY &key)
+        {
+            return stripes_[myHashMix(myKeyHash<KEY>{}(key)) & (kStripeNumber - 1)];
+        }
+
+        // 注销登记，在锁外把结果交给等待回调
+        static void finish(Stripe &stripe, const KEY &key, const VALUE *value, std::exception_ptr error)
+        {
+            std::vector<Waiter> waiters;
+            {
+                std::lock_guard<std::mutex> lock(stripe.mutex_);
+                auto it = stripe.calls_.find(key);
+                waiters = std::move(it->second);
+                stripe.calls_.erase(it);
+            }
+            for (Waiter &waiter : waiters)
+            {
+                waiter(value, error);
+            }
+        }
+
+        std::unique_ptr<Stripe[]> stripes_; // 登记表
+    };
+} // namespace myCacheSystem
+
+#endif // MYSINGLEFLIGHT_H
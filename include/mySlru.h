@@ -0,0 +1,385 @@
+#ifndef MYSLRU_H
+#define MYSLRU_H
+
+#include <algorithm>
+#include <mutex>
+#include "myCachePolicy.h"
+#include "myLru.h"
+#include "myNodePool.h"
+#include "myHash.h"
+#include "myFlatHashMap.h"
+#include "myTimingWheel.h"
+
+namespace myCacheSystem
+{
+    /*
+        分段LRU(SLRU)缓存
+        1. 新key进入试用段，试用段内再次命中时晋升到保护段，保护段内命中移到最近使用端，每次命中只摘挂一次链表
+        2. 保护段超过 protectedRatio 对应的容量时，最久未使用的结点降级回试用段的最近使用端
+        3. 需要淘汰时先淘汰试用段最久未使用的结点，试用段为空时才淘汰保护段
+        只被访问过一次的扫描流量停留在试用段，不会冲掉保护段中的热点数据
+        结点与 myLruCache 相同(myLruNode)，accessCount_ 为1表示在试用段，大于1表示在保护段
+        所有操作在一把互斥锁内完成
+    */
+    template <typename KEY, typename VALUE>
+    class mySlruCache : public myCachePolicy<KEY, VALUE>
+    {
+    public:
+        using LruNodeType = myLruNode<KEY, VALUE>;
+        using NodePtr = LruNodeType *;
+        using NodeMap = myFlatHashMap<KEY, NodePtr>;
+        using NodePool = myNodePool<LruNodeType>;
+        using Weigher = myWeigher<KEY, VALUE>;
+        using TimingWheel = myTimingWheel<LruNodeType>;
+
+        static constexpr size_t kExpireBudget = 16; // 每次写操作最多回收的过期结点数
+
+        /*
+            构造函数
+        */
+        // protectedRatio: 保护段占总容量的比例
+        // weigher 非空时 capacity 为权重预算，两个段都按权重计算，结点池按需扩容
+        explicit mySlruCache(size_t capacity, double protectedRatio = 0.8, Weigher weigher = Weigher())
+            : capacity_(capacity), weigher_(std::move(weigher)), pool_(weigher_ ? 4 : capacity + 4)
+        {
+            protected_.capacity_ = static_cast<size_t>(capacity_ * std::clamp(protectedRatio, 0.0, 1.0));
+            probation_.capacity_ = capacity_ - protected_.capacity_;
+            segmentInit(probation_);
+            segmentInit(protected_);
+            if (!weigher_)
+            {
+                nodeMap_.reserve(capacity_);
+            }
+        }
+
+        ~mySlruCache() override = default;
+
+        /*
+            成员函数接口
+        */
+        // 添加缓存
+        virtual void put(const KEY &key, const VALUE &value) override
+        {
+            putImpl(key, value);
+        }
+
+        virtual void put(KEY &&key, VALUE &&value) override
+        {
+            putImpl(std::move(key), std::move(value));
+        }
+
+        // 添加带过期时间的缓存
+        virtual void put(const KEY &key, const VALUE &value, std::chrono::milliseconds ttl) override
+        {
+            putImpl(key, value, myTimingWheelDeadline(ttl));
+        }
+
+        virtual void put(KEY &&key, VALUE &&value, std::chrono::milliseconds ttl) override
+        {
+            putImpl(std::move(key), std::move(value), myTimingWheelDeadline(ttl));
+        }
+
+        // 获取value
+        virtual bool get(const KEY &key, VALUE &value) override
+        {
+            return getImpl(key, value);
+        }
+
+        virtual VALUE get(const KEY &key) override
+        {
+            VALUE value{};
+            getImpl(key, value);
+            return value;
+        }
+
+        // 透明查找：std::string 键可以直接用 std::string_view 查询
+        template <typename K, typename = std::enable_if_t<myIsTransparentKey_v<KEY, K>>>
+        bool get(const K &key, VALUE &value)
+        {
+            return getImpl(key, value);
+        }
+
+        template <typename K, typename = std::enable_if_t<myIsTransparentKey_v<KEY, K>>>
+        VALUE get(const K &key)
+        {
+            VALUE value{};
+            getImpl(key, value);
+            return value;
+        }
+
+        // 非阻塞接口
+        virtual myTryStatus tryGet(const KEY &key, VALUE &value) override
+        {
+            return lookup<true>(key, value);
+        }
+
+        virtual bool tryPut(const KEY &key, const VALUE &value) override
+        {
+            return putImpl<true>(key, value);
+        }
+
+        virtual bool tryPut(const KEY &key, const VALUE &value, std::chrono::milliseconds ttl) override
+        {
+            return putImpl<true>(key, value, myTimingWheelDeadline(ttl));
+        }
+
+        // 删除指定结点
+        template <typename K>
+        void remove(const K &key)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = nodeMap_.find(key);
+            if (it != nodeMap_.end())
+            {
+                eraseNode(it->second);
+            }
+        }
+
+        // 清空缓存
+        void clear()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto &pair : nodeMap_)
+            {
+                pool_.deallocate(pair.second);
+            }
+            nodeMap_.clear();
+            for (Segment *segment : {&probation_, &protected_})
+            {
+                segment->head_->next_ = segment->tail_;
+                segment->tail_->prev_ = segment->head_;
+                segment->weight_ = 0;
+            }
+            wheel_.clear();
+        }
+
+        // 缓存项数量
+        size_t size() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return nodeMap_.size();
+        }
+
+        // 当前缓存的总权重(未设置权重函数时即缓存项数量)
+        size_t weight() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return probation_.weight_ + protected_.weight_;
+        }
+
+    private:
+        // 段内的LRU链表，头部为最久未使用
+        struct Segment
+        {
+            NodePtr head_ = nullptr; // 虚拟头结点
+            NodePtr tail_ = nullptr; // 虚拟尾结点
+            size_t weight_ = 0;      // 段内总权重
+            size_t capacity_ = 0;    // 容量(权重单位)
+        };
+
+        /*
+            私有成员函数方法
+        */
+        void segmentInit(Segment &segment)
+        {
+            segment.head_ = pool_.allocate();
+            segment.tail_ = pool_.allocate();
+            segment.head_->next_ = segment.tail_;
+            segment.tail_->prev_ = segment.head_;
+        }
+
+        Segment &segmentOf(NodePtr node)
+        {
+            return node->accessCount_ > 1 ? protected_ : probation_;
+        }
+
+        // 插入到段的最近使用端
+        void linkToRecent(Segment &segment, NodePtr node)
+        {
+            NodePtr prev = segment.tail_->prev_;
+            prev->next_ = node;
+            node->next_ = segment.tail_;
+            segment.tail_->prev_ = node;
+            node->prev_ = prev;
+            segment.weight_ += node->weight_;
+        }
+
+        void unlink(Segment &segment, NodePtr node)
+        {
+            node->prev_->next_ = node->next_;
+            node->next_->prev_ = node->prev_;
+            node->prev_ = nullptr;
+            node->next_ = nullptr;
+            segment.weight_ -= node->weight_;
+        }
+
+        // 段中最久未使用的结点，段为空时返回nullptr
+        NodePtr eldest(Segment &segment) const
+        {
+            return segment.head_->next_ != segment.tail_ ? segment.head_->next_ : nullptr;
+        }
+
+        // TRY 为 true 时锁被占用直接返回false
+        template <bool TRY = false, typename K, typename V>
+        bool putImpl(K &&key, V &&value, uint64_t expireTick = 0)
+        {
+            if (capacity_ <= 0)
+                return true;
+
+            std::unique_lock<std::mutex> lock(mutex_, std::defer_lock);
+            if (!myAcquireLock<TRY>(lock))
+            {
+                return false;
+            }
+            expireEntries();
+            auto it = nodeMap_.find(key);
+            if (it != nodeMap_.end())
+            {
+                // 已存在：更新值、权重和过期时间，按一次命中处理
+                NodePtr node = it->second;
+                node->value_ = std::forward<V>(value);
+                size_t weight = weigh(node->key_, node->value_);
+                if (weight > capacity_)
+                {
+                    eraseNode(node);
+                    return true;
+                }
+                Segment &segment = segmentOf(node);
+                segment.weight_ = segment.weight_ - node->weight_ + weight;
+                node->weight_ = weight;
+                setExpiry(node, expireTick);
+                onHit(node);
+                evict();
+                return true;
+            }
+
+            // 超过整个容量的缓存项不缓存
+            size_t weight = weigh(key, value);
+            if (weight > capacity_)
+            {
+                return true;
+            }
+
+            // 新key进入试用段
+            NodePtr node = pool_.allocate();
+            node->key_ = key;
+            node->value_ = std::forward<V>(value);
+            node->accessCount_ = 1;
+            node->weight_ = weight;
+            setExpiry(node, expireTick);
+            linkToRecent(probation_, node);
+            nodeMap_.emplace(std::forward<K>(key), node);
+            evict();
+            return true;
+        }
+
+        template <typename K>
+        bool getImpl(const K &key, VALUE &value)
+        {
+            return lookup(key, value) == myTryStatus::Hit;
+        }
+
+        // 命中时拷贝value并按一次访问处理；TRY 为 true 时锁被占用直接返回 Busy
+        template <bool TRY = false, typename K>
+        myTryStatus lookup(const K &key, VALUE &value)
+        {
+            std::unique_lock<std::mutex> lock(mutex_, std::defer_lock);
+            if (!myAcquireLock<TRY>(lock))
+            {
+                return myTryStatus::Busy;
+            }
+            expireEntries();
+            auto it = nodeMap_.find(key);
+            if (it == nodeMap_.end() || isExpired(it->second))
+            {
+                return myTryStatus::Miss;
+            }
+            value = it->second->value_;
+            onHit(it->second);
+            return myTryStatus::Hit;
+        }
+
+        // 命中：试用段晋升到保护段，保护段移到最近使用端
+        void onHit(NodePtr node)
+        {
+            unlink(segmentOf(node), node);
+            node->addAccessCount();
+            linkToRecent(protected_, node);
+            // 保护段溢出，最久未使用的结点降级回试用段(保护段只剩这一个结点时保留)
+            while (protected_.weight_ > protected_.capacity_ && eldest(protected_) != node)
+            {
+                NodePtr demoted = eldest(protected_);
+                unlink(protected_, demoted);
+                demoted->accessCount_ = 1;
+                linkToRecent(probation_, demoted);
+            }
+        }
+
+        // 总权重超出容量时先淘汰试用段，试用段为空再淘汰保护段
+        void evict()
+        {
+            while (probation_.weight_ + protected_.weight_ > capacity_)
+            {
+                NodePtr victim = eldest(probation_);
+                eraseNode(victim ? victim : eldest(protected_));
+            }
+        }
+
+        // 结点是否已经过期
+        bool isExpired(NodePtr node) const
+        {
+            return node->hasExpiry() && node->isExpired(myTimingWheelNow());
+        }
+
+        // 推进时间轮，回收最多 kExpireBudget 个过期结点(调用者持有锁)
+        void expireEntries()
+        {
+            if (wheel_.empty())
+            {
+                return;
+            }
+            wheel_.expire(myTimingWheelNow(), kExpireBudget, [this](NodePtr node)
+                          { eraseNode(node); });
+        }
+
+        // 设置结点的过期刻度，0表示不过期
+        void setExpiry(NodePtr node, uint64_t expireTick)
+        {
+            if (expireTick != 0)
+            {
+                wheel_.schedule(node, expireTick);
+            }
+            else
+            {
+                wheel_.cancel(node);
+            }
+        }
+
+        // 从段链表、哈希表和时间轮中删除结点并归还结点池
+        void eraseNode(NodePtr node)
+        {
+            unlink(segmentOf(node), node);
+            nodeMap_.erase(node->key_);
+            wheel_.cancel(node);
+            pool_.deallocate(node);
+        }
+
+        // 计算缓存项权重
+        template <typename K, typename V>
+        size_t weigh(const K &key, const V &value) const
+        {
+            return weigher_ ? weigher_(key, value) : 1;
+        }
+
+        size_t capacity_;          // 总容量(权重单位)
+        Weigher weigher_;          // 权重函数，为空时每个结点权重为1
+        mutable std::mutex mutex_; // 互斥锁
+        NodePool pool_;            // 结点池(含两个段的虚拟头尾结点)
+        NodeMap nodeMap_;          // key——结点映射
+        TimingWheel wheel_;        // 时间轮，管理设置了过期时间的结点
+        Segment probation_;        // 试用段
+        Segment protected_;        // 保护段
+    };
+} // namespace myCacheSystem
+
+#endif // MYSLRU_H
@@ -0,0 +1,302 @@
+#ifndef MYTASK_H
+#define MYTASK_H
+
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace myCacheSystem
+{
+    template <typename T>
+    class myTask;
+
+    /*
+        myTask 的 promise 公共部分
+        协程创建后先挂起，被 co_await 时才开始执行；执行结束时直接切换回等待它的协程(对称转移)，不经过调度器
+    */
+    class myTaskPromiseBase
+    {
+    public:
+        // 结束时切换回等待者，没有等待者时返回调用方
+        struct FinalAwaiter
+        {
+            bool await_ready() const noexcept { return false; }
+
+            template <typename PROMISE>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<PROMISE> handle) noexcept
+            {
+                std::coroutine_handle<> continuation = handle.promise().continuation_;
+                return continuation ? continuation : std::noop_coroutine();
+            }
+
+            void await_resume() const noexcept {}
+        };
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        FinalAwaiter final_suspend() noexcept { return {}; }
+
+        void unhandled_exception() { error_ = std::current_exception(); }
+
+        std::coroutine_handle<> continuation_; // 等待该任务的协程
+        std::exception_ptr error_;             // 任务抛出的异常
+    };
+
+    template <typename T>
+    class myTaskPromise : public myTaskPromiseBase
+    {
+    public:
+        myTask<T> get_return_object();
+
+        template <typename V>
+        void return_value(V &&value) { value_.emplace(std::forward<V>(value)); }
+
+        T result()
+        {
+            if (error_)
+            {
+                std::rethrow_exception(error_);
+            }
+            return std::move(*value_);
+        }
+
+    private:
+        std::optional<T> value_; // 任务的返回值
+    };
+
+    template <>
+    class myTaskPromise<void> : public myTaskPromiseBase
+    {
+    public:
+        myTask<void> get_return_object();
+
+        void return_void() {}
+
+        void result()
+        {
+            if (error_)
+            {
+                std::rethrow_exception(error_);
+            }
+        }
+    };
+
+    /*
+        惰性协程任务：co_await 时才开始执行，结果(或异常)在 co_await 处返回
+        只能被 co_await 一次；不在协程中的代码用 mySyncWait/mySyncWaitAll 阻塞等待
+    */
+    template <typename T = void>
+    class [[nodiscard]] myTask
+    {
+    public:
+        using promise_type = myTaskPromise<T>;
+        using Handle = std::coroutine_handle<promise_type>;
+
+        /*
+            构造函数
+        */
+        myTask() : handle_(nullptr) {}
+
+        explicit myTask(Handle handle) : handle_(handle) {}
+
+        myTask(myTask &&other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+
+        myTask &operator=(myTask &&other) noexcept
+        {
+            if (this != &other)
+            {
+                destroy();
+                handle_ = std::exchange(other.handle_, nullptr);
+            }
+            return *this;
+        }
+
+        myTask(const myTask &) = delete;
+        myTask &operator=(const myTask &) = delete;
+
+        ~myTask()
+        {
+            destroy();
+        }
+
+        /*
+            成员函数接口
+        */
+        auto operator co_await() && noexcept
+        {
+            struct Awaiter
+            {
+                Handle handle_;
+
+                bool await_ready() const noexcept { return !handle_ || handle_.done(); }
+
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<> continuation) noexcept
+                {
+                    handle_.promise().continuation_ = continuation;
+                    return handle_;
+                }
+
+                T await_resume() { return handle_.promise().result(); }
+            };
+            return Awaiter{handle_};
+        }
+
+    private:
+        void destroy()
+        {
+            if (handle_)
+            {
+                handle_.destroy();
+                handle_ = nullptr;
+            }
+        }
+
+        Handle handle_; // 协程帧
+    };
+
+    template <typename T>
+    myTask<T> myTaskPromise<T>::get_return_object()
+    {
+        return myTask<T>(std::coroutine_handle<myTaskPromise<T>>::from_promise(*this));
+    }
+
+    inline myTask<void> myTaskPromise<void>::get_return_object()
+    {
+        return myTask<void>(std::coroutine_handle<myTaskPromise<void>>::from_promise(*this));
+    }
+
+    /*
+        阻塞等待一组任务
+        所有任务在调用线程上依次启动，各自运行到第一次挂起为止，之后由恢复它们的线程(如 executor 的工作线程)继续执行
+        状态由等待线程和各个任务共同持有，最后一个任务完成时通知等待线程
+    */
+    template <typename T>
+    class mySyncWaitState
+    {
+    public:
+        using Result = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+        explicit mySyncWaitState(size_t count) : remaining_(count), results_(count) {}
+
+        // 任务完成(error 非空表示抛出了异常)
+        void finish(std::exception_ptr error)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (error && !error_)
+            {
+                error_ = error;
+            }
+            if (--remaining_ == 0)
+            {
+                cond_.notify_all();
+            }
+        }
+
+        // 等待所有任务完成，有任务抛出异常时重新抛出第一个
+        void wait()
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cond_.wait(lock, [this]()
+                       { return remaining_ == 0; });
+            if (error_)
+            {
+                std::rethrow_exception(error_);
+            }
+        }
+
+        std::vector<std::optional<Result>> &results() { return results_; }
+
+    private:
+        std::mutex mutex_;
+        std::condition_variable cond_;
+        size_t remaining_;                          // 未完成的任务数
+        std::exception_ptr error_;                  // 第一个抛出的异常
+        std::vector<std::optional<Result>> results_; // 各任务的返回值
+    };
+
+    // 启动后不再被等待的协程，执行结束时自动释放协程帧
+    struct myDetachedTask
+    {
+        struct promise_type
+        {
+            myDetachedTask get_return_object() { return {}; }
+            std::suspend_never initial_suspend() noexcept { return {}; }
+            std::suspend_never final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { std::terminate(); }
+        };
+    };
+
+    template <typename T>
+    myDetachedTask myRunTask(myTask<T> task, std::shared_ptr<mySyncWaitState<T>> state, size_t index)
+    {
+        std::exception_ptr error;
+        try
+        {
+            if constexpr (std::is_void_v<T>)
+            {
+                co_await std::move(task);
+                state->results()[index].emplace();
+            }
+            else
+            {
+                state->results()[index].emplace(co_await std::move(task));
+            }
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+        state->finish(error);
+    }
+
+    // 阻塞等待所有任务完成，返回按下标对应的结果(myTask<void> 时不返回)
+    template <typename T>
+    auto mySyncWaitAll(std::vector<myTask<T>> tasks)
+    {
+        auto state = std::make_shared<mySyncWaitState<T>>(tasks.size());
+        for (size_t i = 0; i < tasks.size(); ++i)
+        {
+            myRunTask(std::move(tasks[i]), state, i);
+        }
+        if (!tasks.empty())
+        {
+            state->wait();
+        }
+        if constexpr (!std::is_void_v<T>)
+        {
+            std::vector<T> results;
+            results.reserve(tasks.size());
+            for (auto &result : state->results())
+            {
+                results.push_back(std::move(*result));
+            }
+            return results;
+        }
+    }
+
+    // 阻塞等待一个任务完成并返回它的结果
+    template <typename T>
+    T mySyncWait(myTask<T> task)
+    {
+        std::vector<myTask<T>> tasks;
+        tasks.push_back(std::move(task));
+        if constexpr (std::is_void_v<T>)
+        {
+            mySyncWaitAll(std::move(tasks));
+        }
+        else
+        {
+            return std::move(mySyncWaitAll(std::move(tasks)).front());
+        }
+    }
+} // namespace myCacheSystem
+
+#endif // MYTASK_H
@@ -0,0 +1,321 @@
+#ifndef MYTIMINGWHEEL_H
+#define MYTIMINGWHEEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <bit>
+#include <memory>
+
+namespace myCacheSystem
+{
+    // 前向声明
+    template <typename NODE>
+    class myTimingWheel;
+
+    /*
+        过期时间以毫秒刻度(tick)表示，取 steady_clock 自身纪元起的绝对刻度，
+        不同缓存(分片、ARC的两部分)之间的刻度可以直接比较和传递
+    */
+    inline uint64_t myTimingWheelNow()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    // ttl 之后的过期刻度
+    inline uint64_t myTimingWheelDeadline(std::chrono::milliseconds ttl)
+    {
+        return myTimingWheelNow() + static_cast<uint64_t>(std::max<int64_t>(ttl.count(), 0));
+    }
+
+    /*
+        时间轮的侵入式钩子，缓存结点继承它即可挂到时间轮上，挂载和取消都不需要额外分配内存
+        另外记录 refresh-ahead 的刷新刻度(见 myRefreshAhead)，由缓存在写入时设置，命中时在读锁下认领
+    */
+    class myTimerNode
+    {
+        template <typename NODE>
+        friend class myTimingWheel;
+
+    public:
+        myTimerNode() : expireTick_(0), refreshTick_(0), timerSlot_(0), timerPrev_(nullptr), timerNext_(nullptr) {}
+
+        // 是否设置了过期时间
+        bool hasExpiry() const { return expireTick_ != 0; }
+
+        // 过期刻度，0表示不过期
+        uint64_t getExpireTick() const { return expireTick_; }
+
+        // 在 nowTick 时是否已经过期
+        bool isExpired(uint64_t nowTick) const { return expireTick_ != 0 && expireTick_ <= nowTick; }
+
+        // 刷新刻度，0表示不需要刷新或刷新已经被认领
+        uint64_t getRefreshTick() const { return refreshTick_.load(std::memory_order_relaxed); }
+
+        void setRefreshTick(uint64_t tick) { refreshTick_.store(tick, std::memory_order_relaxed); }
+
+        // 认领一次刷新：并发的读者中只有一个能把刷新刻度从 tick 换成0
+        bool claimRefresh(uint64_t tick) { return refreshTick_.compare_exchange_strong(tick, 0, std::memory_order_relaxed); }
+
+    private:
+        uint64_t expireTick_;    // 过期刻度
+        std::atomic<uint64_t> refreshTick_; // 刷新刻度
+        uint32_t timerSlot_;     // 所在的槽位(层 * 槽数 + 槽)
+        myTimerNode *timerPrev_; // 槽位链表(带哨兵的循环链表)
+        myTimerNode *timerNext_;
+    };
+
+    /*
+        分层时间轮
+        1. 6层，每层64个槽位，第L层一个槽位覆盖 64^L 个刻度，共覆盖 2^36 毫秒(约两年)，更远的过期时间放在最高层并在轮转时重新放置
+        2. 结点按过期刻度与当前刻度最高的不同位决定所在层，schedule/cancel 都是 O(1) 的链表操作
+        3. 当前刻度走到高层槽位的起点时，把该槽位的结点重新放置到低层(级联)，每个结点最多级联层数次，过期处理均摊 O(1)
+        4. 每层维护非空槽位的位图，推进时直接跳过空槽位；第0层本轮为空时按高层位图直接跳到下一次级联的刻度
+        时间轮本身不加锁，由所属缓存在写锁下调用；槽位在第一次 schedule 时才分配，不使用过期时间的缓存没有额外开销
+        NODE 需要公有继承 myTimerNode
+    */
+    template <typename NODE>
+    class myTimingWheel
+    {
+    public:
+        static constexpr size_t kSlotBits = 6;
+        static constexpr size_t kSlotNumber = size_t(1) << kSlotBits;
+        static constexpr size_t kLevelNumber = 6;
+
+        /*
+            构造函数
+        */
+        myTimingWheel() : currentTick_(0), size_(0) {}
+
+        myTimingWheel(const myTimingWheel &) = delete;
+        myTimingWheel &operator=(const myTimingWheel &) = delete;
+
+        /*
+            成员函数接口
+        */
+        // 挂到时间轮上(已经挂载则重新放置)
+        void schedule(NODE *node, uint64_t expireTick)
+        {
+            if (!slots_)
+            {
+                initSlots();
+            }
+            unlink(node);
+            node->expireTick_ = expireTick;
+            place(node);
+            ++size_;
+        }
+
+        // 从时间轮上取下并清除过期时间
+        void cancel(NODE *node)
+        {
+            unlink(node);
+            node->expireTick_ = 0;
+        }
+
+        // 挂载的结点数
+        size_t size() const { return size_; }
+
+        bool empty() const { return size_ == 0; }
+
+        /*
+            推进到 nowTick，对过期结点调用 onExpire(NODE*)(调用前结点已从时间轮取下)
+            最多处理 budget 个结点，处理不完的留到下次调用，返回本次处理的数量
+        */
+        template <typename FUNC>
+        size_t expire(uint64_t nowTick, size_t budget, FUNC &&onExpire)
+        {
+            size_t expired = 0;
+            while (currentTick_ <= nowTick)
+            {
+                // 没有挂载的结点，直接跳到 nowTick 之后
+                if (size_ == 0)
+                {
+                    currentTick_ = nowTick + 1;
+                    break;
+                }
+                // 处理当前刻度的槽位
+                size_t slot = currentTick_ & (kSlotNumber - 1);
+                myTimerNode *head = &slotHead(0, slot);
+                while (head->timerNext_ != head)
+                {
+                    if (expired == budget)
+                    {
+                        return expired;
+                    }
+                    NODE *node = static_cast<NODE *>(head->timerNext_);
+                    cancel(node);
+                    onExpire(node);
+                    ++expired;
+                }
+                // 跳到本轮下一个非空槽位；本轮没有时直接跳到高层最近一个非空槽位的起点(需要级联)，
+                // 长时间空闲后不必逐轮推进；都不超过 nowTick + 1
+                uint64_t next;
+                uint64_t later = nextOccupied(0, slot);
+                if (later != kSlotNumber)
+                {
+                    next = (currentTick_ & ~uint64_t(kSlotNumber - 1)) + later;
+                }
+                else
+                {
+                    next = nextCascadeTick();
+                }
+                currentTick_ = std::min(next, nowTick + 1);
+                if ((currentTick_ & (kSlotNumber - 1)) == 0)
+                {
+                    cascade();
+                }
+            }
+            return expired;
+        }
+
+        // 取下所有结点
+        void clear()
+        {
+            if (!slots_)
+            {
+                return;
+            }
+            for (size_t i = 0; i < kLevelNumber * kSlotNumber; ++i)
+            {
+                myTimerNode *head = &slots_[i];
+                while (head->timerNext_ != head)
+                {
+                    cancel(static_cast<NODE *>(head->timerNext_));
+                }
+            }
+        }
+
+    private:
+        void initSlots()
+        {
+            slots_ = std::make_unique<myTimerNode[]>(kLevelNumber * kSlotNumber);
+            for (size_t i = 0; i < kLevelNumber * kSlotNumber; ++i)
+            {
+                slots_[i].timerPrev_ = &slots_[i];
+                slots_[i].timerNext_ = &slots_[i];
+            }
+            for (auto &bits : occupied_)
+            {
+                bits = 0;
+            }
+            currentTick_ = myTimingWheelNow();
+        }
+
+        myTimerNode &slotHead(size_t level, size_t slot)
+        {
+            return slots_[level * kSlotNumber + slot];
+        }
+
+        // 按过期刻度放置到对应的层和槽位
+        void place(myTimerNode *node)
+        {
+            size_t level = 0;
+            size_t slot = currentTick_ & (kSlotNumber - 1);
+            if (node->expireTick_ > currentTick_)
+            {
+                // 与当前刻度最高的不同位决定层
+                size_t highBit = 63 - std::countl_zero(node->expireTick_ ^ currentTick_);
+                level = std::min(highBit / kSlotBits, kLevelNumber - 1);
+                slot = (node->expireTick_ >> (level * kSlotBits)) & (kSlotNumber - 1);
+            }
+            myTimerNode *head = &slotHead(level, slot);
+            node->timerSlot_ = static_cast<uint32_t>(level * kSlotNumber + slot);
+            node->timerNext_ = head;
+            node->timerPrev_ = head->timerPrev_;
+            head->timerPrev_->timerNext_ = node;
+            head->timerPrev_ = node;
+            occupied_[level] |= uint64_t(1) << slot;
+        }
+
+        void unlink(myTimerNode *node)
+        {
+            if (!node->timerNext_)
+            {
+                return;
+            }
+            node->timerPrev_->timerNext_ = node->timerNext_;
+            node->timerNext_->timerPrev_ = node->timerPrev_;
+            // 槽位变空时清除位图
+            if (node->timerNext_ == node->timerPrev_)
+            {
+                occupied_[node->timerSlot_ / kSlotNumber] &= ~(uint64_t(1) << (node->timerSlot_ % kSlotNumber));
+            }
+            node->timerPrev_ = nullptr;
+            node->timerNext_ = nullptr;
+            --size_;
+        }
+
+        // level 层中 slot 之后第一个非空槽位，没有时返回 kSlotNumber
+        size_t nextOccupied(size_t level, size_t slot) const
+        {
+            uint64_t later = slot + 1 < kSlotNumber ? (occupied_[level] >> (slot + 1)) << (slot + 1) : 0;
+            return later != 0 ? std::countr_zero(later) : kSlotNumber;
+        }
+
+        /*
+            当前刻度之后最早需要级联的刻度，即各高层下一个非空槽位起点的最小值
+            第L层(L < 最高层)的结点与当前刻度在第L层以上的位相同，只会在当前槽位之后；
+            最高层的结点可能超出范围而回绕，当前槽位及之前的非空槽位属于下一轮
+        */
+        uint64_t nextCascadeTick() const
+        {
+            uint64_t next = UINT64_MAX;
+            for (size_t level = 1; level < kLevelNumber; ++level)
+            {
+                size_t shift = level * kSlotBits;
+                size_t slot = (currentTick_ >> shift) & (kSlotNumber - 1);
+                uint64_t round = currentTick_ & ~((uint64_t(1) << (shift + kSlotBits)) - 1);
+                size_t later = nextOccupied(level, slot);
+                if (later != kSlotNumber)
+                {
+                    next = std::min(next, round + (uint64_t(later) << shift));
+                }
+                else if (level == kLevelNumber - 1 && occupied_[level] != 0)
+                {
+                    uint64_t first = std::countr_zero(occupied_[level]);
+                    next = std::min(next, round + (uint64_t(1) << (shift + kSlotBits)) + (first << shift));
+                }
+            }
+            return next;
+        }
+
+        // 当前刻度走到高层槽位起点时，从高到低把这些槽位的结点重新放置
+        void cascade()
+        {
+            for (size_t level = kLevelNumber - 1; level > 0; --level)
+            {
+                if ((currentTick_ & ((uint64_t(1) << (level * kSlotBits)) - 1)) != 0)
+                {
+                    continue;
+                }
+                size_t slot = (currentTick_ >> (level * kSlotBits)) & (kSlotNumber - 1);
+                if (!(occupied_[level] & (uint64_t(1) << slot)))
+                {
+                    continue;
+                }
+                // 先把整个槽位摘下，重新放置的结点可能回到同一个槽位(超出最高层范围时)
+                myTimerNode *head = &slotHead(level, slot);
+                myTimerNode *node = head->timerNext_;
+                head->timerPrev_->timerNext_ = nullptr;
+                head->timerNext_ = head;
+                head->timerPrev_ = head;
+                occupied_[level] &= ~(uint64_t(1) << slot);
+                while (node)
+                {
+                    myTimerNode *next = node->timerNext_;
+                    place(node);
+                    node = next;
+                }
+            }
+        }
+
+        uint64_t currentTick_;                   // 下一个要处理的刻度
+        size_t size_;                            // 挂载的结点数
+        uint64_t occupied_[kLevelNumber];        // 每层非空槽位的位图
+        std::unique_ptr<myTimerNode[]> slots_;   // 各层槽位的哨兵结点
+    };
+} // namespace myCacheSystem
+
+#endif // MYTIMINGWHEEL_H
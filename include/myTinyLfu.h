@@ -0,0 +1,449 @@
+#ifndef MYTINYLFU_H
+#define MYTINYLFU_H
+
+#include <algorithm>
+#include <mutex>
+#include "myCachePolicy.h"
+#include "myNodePool.h"
+#include "myHash.h"
+#include "myFlatHashMap.h"
+#include "myFrequencySketch.h"
+#include "myTimingWheel.h"
+
+namespace myCacheSystem
+{
+    // 前向声明
+    template <typename KEY, typename VALUE>
+    class myTinyLfuCache;
+
+    // 结点所在的区域
+    enum class myTinyLfuRegion : uint8_t
+    {
+        Window,    // 准入窗口
+        Probation, // 主区试用段
+        Protected  // 主区保护段
+    };
+
+    // W-TinyLFU的缓存节点，继承时间轮钩子以支持过期时间
+    template <typename KEY, typename VALUE>
+    class myTinyLfuNode : public myTimerNode
+    {
+        friend class myTinyLfuCache<KEY, VALUE>;
+
+    public:
+        /*
+            构造函数
+        */
+        myTinyLfuNode() : region_(myTinyLfuRegion::Window), next_(nullptr), prev_(nullptr) {}
+
+        /*
+            成员函数接口
+        */
+        KEY getKey() const
+        {
+            return key_;
+        }
+
+        VALUE getValue() const
+        {
+            return value_;
+        }
+
+        myTinyLfuRegion getRegion() const
+        {
+            return region_;
+        }
+
+        // 释放键值，结点归还 myNodePool 时调用，空闲栈中的结点不再占用键值的内存
+        void releasePayload()
+        {
+            key_ = KEY();
+            value_ = VALUE();
+        }
+
+    private:
+        KEY key_;
+        VALUE value_;
+        myTinyLfuRegion region_;          // 所在区域
+        myTinyLfuNode<KEY, VALUE> *next_; // 结点由myNodePool统一管理，使用裸指针侵入式链接
+        myTinyLfuNode<KEY, VALUE> *prev_;
+    };
+
+    /*
+        W-TinyLFU 缓存
+        1. 新key先进入准入窗口(默认容量的1%)，窗口是一个LRU，突发的新key在窗口内就能命中
+        2. 窗口溢出的结点作为候选者进入主区，主区满时与主区的淘汰者(试用段最久未使用的结点)比较sketch估计的频次，
+           候选者频次更高才留下，否则淘汰候选者——一次性访问的key不会挤掉热点数据
+        3. 主区是分段LRU：试用段命中后晋升到保护段(主区的80%)，保护段溢出的结点降级回试用段
+        4. 所有访问(包括未命中和写入)都记录到4位 Count-Min Sketch，sketch定期减半以跟随访问模式变化
+        所有操作在一把互斥锁内完成，命中、准入和淘汰都是 O(1)
+    */
+    template <typename KEY, typename VALUE>
+    class myTinyLfuCache : public myCachePolicy<KEY, VALUE>
+    {
+    public:
+        typedef myTinyLfuNode<KEY, VALUE> TinyLfuNodeType;
+        typedef TinyLfuNodeType *NodePtr;
+        typedef myFlatHashMap<KEY, NodePtr> NodeMap;
+        typedef myNodePool<TinyLfuNodeType> NodePool;
+        typedef myTimingWheel<TinyLfuNodeType> TimingWheel;
+
+        static constexpr size_t kExpireBudget = 16; // 每次写操作最多回收的过期结点数
+
+        /*
+            构造函数
+        */
+        // windowRatio: 准入窗口占总容量的比例，至少1个结点
+        explicit myTinyLfuCache(size_t capacity, double windowRatio = 0.01)
+            : capacity_(capacity), sketch_(capacity), pool_(capacity + 6)
+        {
+            size_t windowCapacity = std::clamp<size_t>(static_cast<size_t>(capacity * windowRatio), 1, std::max<size_t>(capacity, 1));
+            mainCapacity_ = capacity_ > windowCapacity ? capacity_ - windowCapacity : 0;
+            window_.capacity_ = windowCapacity;
+            protected_.capacity_ = mainCapacity_ - mainCapacity_ / 5;
+            probation_.capacity_ = mainCapacity_ - protected_.capacity_;
+            for (Segment *segment : {&window_, &probation_, &protected_})
+            {
+                segmentInit(*segment);
+            }
+            nodeMap_.reserve(capacity_);
+        }
+
+        ~myTinyLfuCache() override = default;
+
+        /*
+            成员函数接口
+        */
+        // 添加缓存
+        virtual void put(const KEY &key, const VALUE &value) override
+        {
+            putImpl(key, value);
+        }
+
+        virtual void put(KEY &&key, VALUE &&value) override
+        {
+            putImpl(std::move(key), std::move(value));
+        }
+
+        // 添加带过期时间的缓存
+        virtual void put(const KEY &key, const VALUE &value, std::chrono::milliseconds ttl) override
+        {
+            putImpl(key, value, myTimingWheelDeadline(ttl));
+        }
+
+        virtual void put(KEY &&key, VALUE &&value, std::chrono::milliseconds ttl) override
+        {
+            putImpl(std::move(key), std::move(value), myTimingWheelDeadline(ttl));
+        }
+
+        // 获取value
+        virtual bool get(const KEY &key, VALUE &value) override
+        {
+            return getImpl(key, value);
+        }
+
+        virtual VALUE get(const KEY &key) override
+        {
+            VALUE value{};
+            getImpl(key, value);
+            return value;
+        }
+
+        // 透明查找：std::string 键可以直接用 std::string_view 查询
+        template <typename K, typename = std::enable_if_t<myIsTransparentKey_v<KEY, K>>>
+        bool get(const K &key, VALUE &value)
+        {
+            return getImpl(key, value);
+        }
+
+        template <typename K, typename = std::enable_if_t<myIsTransparentKey_v<KEY, K>>>
+        VALUE get(const K &key)
+        {
+            VALUE value{};
+            getImpl(key, value);
+            return value;
+        }
+
+        // 非阻塞接口
+        virtual myTryStatus tryGet(const KEY &key, VALUE &value) override
+        {
+            return lookup<true>(key, value);
+        }
+
+        virtual bool tryPut(const KEY &key, const VALUE &value) override
+        {
+            return putImpl<true>(key, value);
+        }
+
+        virtual bool tryPut(const KEY &key, const VALUE &value, std::chrono::milliseconds ttl) override
+        {
+            return putImpl<true>(key, value, myTimingWheelDeadline(ttl));
+        }
+
+        // 清空缓存，sketch 一并清零
+        void clear()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto &pair : nodeMap_)
+            {
+                pool_.deallocate(pair.second);
+            }
+            nodeMap_.clear();
+            for (Segment *segment : {&window_, &probation_, &protected_})
+            {
+                segment->head_->next_ = segment->tail_;
+                segment->tail_->prev_ = segment->head_;
+                segment->size_ = 0;
+            }
+            wheel_.clear();
+            sketch_.clear();
+        }
+
+        // 缓存项数量
+        size_t size() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return nodeMap_.size();
+        }
+
+    private:
+        // 区域内的LRU链表，头部为最久未使用
+        struct Segment
+        {
+            NodePtr head_ = nullptr; // 虚拟头结点
+            NodePtr tail_ = nullptr; // 虚拟尾结点
+            size_t size_ = 0;        // 结点数
+            size_t capacity_ = 0;    // 容量
+        };
+
+        /*
+            私有成员函数方法
+        */
+        void segmentInit(Segment &segment)
+        {
+            segment.head_ = pool_.allocate();
+            segment.tail_ = pool_.allocate();
+            segment.head_->next_ = segment.tail_;
+            segment.tail_->prev_ = segment.head_;
+        }
+
+        Segment &segmentOf(NodePtr node)
+        {
+            switch (node->region_)
+            {
+            case myTinyLfuRegion::Window:
+                return window_;
+            case myTinyLfuRegion::Probation:
+                return probation_;
+            default:
+                return protected_;
+            }
+        }
+
+        // 插入到区域的最近使用端
+        void linkToRecent(Segment &segment, NodePtr node)
+        {
+            NodePtr prev = segment.tail_->prev_;
+            prev->next_ = node;
+            node->next_ = segment.tail_;
+            segment.tail_->prev_ = node;
+            node->prev_ = prev;
+            ++segment.size_;
+        }
+
+        void unlink(Segment &segment, NodePtr node)
+        {
+            node->prev_->next_ = node->next_;
+            node->next_->prev_ = node->prev_;
+            node->prev_ = nullptr;
+            node->next_ = nullptr;
+            --segment.size_;
+        }
+
+        // 移动到另一个区域的最近使用端
+        void moveTo(NodePtr node, myTinyLfuRegion region)
+        {
+            unlink(segmentOf(node), node);
+            node->region_ = region;
+            linkToRecent(segmentOf(node), node);
+        }
+
+        // 区域中最久未使用的结点，区域为空时返回nullptr
+        NodePtr eldest(Segment &segment) const
+        {
+            return segment.size_ > 0 ? segment.head_->next_ : nullptr;
+        }
+
+        // TRY 为 true 时锁被占用直接返回false
+        template <bool TRY = false, typename K, typename V>
+        bool putImpl(K &&key, V &&value, uint64_t expireTick = 0)
+        {
+            if (capacity_ <= 0)
+                return true;
+
+            std::unique_lock<std::mutex> lock(mutex_, std::defer_lock);
+            if (!myAcquireLock<TRY>(lock))
+            {
+                return false;
+            }
+            expireEntries();
+            sketch_.increment(key);
+            auto it = nodeMap_.find(key);
+            if (it != nodeMap_.end())
+            {
+                // 已存在：更新值和过期时间，按一次命中处理
+                NodePtr node = it->second;
+                node->value_ = std::forward<V>(value);
+                setExpiry(node, expireTick);
+                onHit(node);
+                return true;
+            }
+
+            // 新key进入准入窗口
+            NodePtr node = pool_.allocate();
+            node->key_ = key;
+            node->value_ = std::forward<V>(value);
+            node->region_ = myTinyLfuRegion::Window;
+            setExpiry(node, expireTick);
+            linkToRecent(window_, node);
+            nodeMap_.emplace(std::forward<K>(key), node);
+            evict();
+            return true;
+        }
+
+        template <typename K>
+        bool getImpl(const K &key, VALUE &value)
+        {
+            return lookup(key, value) == myTryStatus::Hit;
+        }
+
+        // 命中时拷贝value并按一次访问处理；TRY 为 true 时锁被占用直接返回 Busy
+        template <bool TRY = false, typename K>
+        myTryStatus lookup(const K &key, VALUE &value)
+        {
+            std::unique_lock<std::mutex> lock(mutex_, std::defer_lock);
+            if (!myAcquireLock<TRY>(lock))
+            {
+                return myTryStatus::Busy;
+            }
+            expireEntries();
+            sketch_.increment(key);
+            auto it = nodeMap_.find(key);
+            if (it == nodeMap_.end() || isExpired(it->second))
+            {
+                return myTryStatus::Miss;
+            }
+            value = it->second->value_;
+            onHit(it->second);
+            return myTryStatus::Hit;
+        }
+
+        // 命中：窗口和保护段内移到最近使用端，试用段晋升到保护段
+        void onHit(NodePtr node)
+        {
+            switch (node->region_)
+            {
+            case myTinyLfuRegion::Window:
+            case myTinyLfuRegion::Protected:
+                moveTo(node, node->region_);
+                break;
+            case myTinyLfuRegion::Probation:
+                moveTo(node, myTinyLfuRegion::Protected);
+                // 保护段溢出，最久未使用的结点降级回试用段
+                while (protected_.size_ > protected_.capacity_)
+                {
+                    moveTo(eldest(protected_), myTinyLfuRegion::Probation);
+                }
+                break;
+            }
+        }
+
+        // 窗口溢出的结点进入试用段，主区超出容量时由 TinyLFU 决定淘汰候选者还是淘汰者
+        void evict()
+        {
+            NodePtr candidate = nullptr;
+            while (window_.size_ > window_.capacity_)
+            {
+                candidate = eldest(window_);
+                moveTo(candidate, myTinyLfuRegion::Probation);
+            }
+            while (probation_.size_ + protected_.size_ > mainCapacity_)
+            {
+                NodePtr victim = eldest(probation_);
+                if (victim == candidate)
+                {
+                    // 试用段只剩候选者，淘汰者取保护段最久未使用的结点
+                    victim = victim->next_ != probation_.tail_ ? victim->next_ : eldest(protected_);
+                }
+                if (!candidate || !victim)
+                {
+                    eraseNode(victim ? victim : candidate);
+                    candidate = nullptr;
+                    continue;
+                }
+                // 候选者的估计频次更高才准入，否则淘汰候选者
+                if (sketch_.frequency(candidate->key_) > sketch_.frequency(victim->key_))
+                {
+                    eraseNode(victim);
+                }
+                else
+                {
+                    eraseNode(candidate);
+                }
+                candidate = nullptr;
+            }
+        }
+
+        // 结点是否已经过期
+        bool isExpired(NodePtr node) const
+        {
+            return node->hasExpiry() && node->isExpired(myTimingWheelNow());
+        }
+
+        // 推进时间轮，回收最多 kExpireBudget 个过期结点(调用者持有锁)
+        void expireEntries()
+        {
+            if (wheel_.empty())
+            {
+                return;
+            }
+            wheel_.expire(myTimingWheelNow(), kExpireBudget, [this](NodePtr node)
+                          { eraseNode(node); });
+        }
+
+        // 设置结点的过期刻度，0表示不过期
+        void setExpiry(NodePtr node, uint64_t expireTick)
+        {
+            if (expireTick != 0)
+            {
+                wheel_.schedule(node, expireTick);
+            }
+            else
+            {
+                wheel_.cancel(node);
+            }
+        }
+
+        // 从区域链表、哈希表和时间轮中删除结点并归还结点池
+        void eraseNode(NodePtr node)
+        {
+            unlink(segmentOf(node), node);
+            nodeMap_.erase(node->key_);
+            wheel_.cancel(node);
+            pool_.deallocate(node);
+        }
+
+        size_t capacity_;                  // 总容量
+        size_t mainCapacity_;              // 主区容量(试用段 + 保护段)
+        mutable std::mutex mutex_;         // 互斥锁
+        myFrequencySketch<KEY> sketch_;    // 访问频次估计
+        NodePool pool_;                    // 结点池(含各区域的虚拟头尾结点)
+        NodeMap nodeMap_;                  // key——结点映射
+        TimingWheel wheel_;                // 时间轮，管理设置了过期时间的结点
+        Segment window_;                   // 准入窗口
+        Segment probation_;                // 试用段
+        Segment protected_;                // 保护段
+    };
+} // namespace myCacheSystem
+
+#endif // MYTINYLFU_H
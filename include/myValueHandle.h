@@ -0,0 +1,118 @@
+#ifndef MYVALUEHANDLE_H
+#define MYVALUEHANDLE_H
+
+#include <deque>
+#include <utility>
+#include "myEpochReclaimer.h"
+
+namespace myCacheSystem
+{
+    /*
+        零拷贝读取句柄：指向缓存中保存的value，持有期间value不会被修改、移动或释放
+        句柄内含一个纪元临界区(myEpochReclaimer::Guard)，被淘汰或覆盖的结点要等所有句柄释放后才会复用，
+        因此句柄应当短期持有，长期持有会让被摘下的结点无法回收；句柄不能比产生它的缓存存活得更久
+        句柄可以移动，不可拷贝；未命中时返回空句柄
+    */
+    template <typename VALUE>
+    class myValueHandle
+    {
+    public:
+        /*
+            构造函数
+        */
+        myValueHandle() : value_(nullptr) {}
+
+        myValueHandle(myEpochReclaimer::Guard guard, const VALUE *value)
+            : guard_(std::move(guard)), value_(value)
+        {
+        }
+
+        myValueHandle(myValueHandle &&) noexcept = default;
+        myValueHandle &operator=(myValueHandle &&) noexcept = default;
+        myValueHandle(const myValueHandle &) = delete;
+        myValueHandle &operator=(const myValueHandle &) = delete;
+
+        /*
+            成员函数接口
+        */
+        // 是否命中
+        explicit operator bool() const { return value_ != nullptr; }
+
+        const VALUE &operator*() const { return *value_; }
+
+        const VALUE *operator->() const { return value_; }
+
+        const VALUE *get() const { return value_; }
+
+        // 提前释放句柄
+        void reset()
+        {
+            guard_ = myEpochReclaimer::Guard();
+            value_ = nullptr;
+        }
+
+    private:
+        myEpochReclaimer::Guard guard_; // 纪元临界区
+        const VALUE *value_;            // 缓存中的value
+    };
+
+    /*
+        被句柄引用过的结点的延迟回收
+        缓存在结点上记录是否交出过句柄；这样的结点被淘汰、删除或覆盖时不直接归还结点池，
+        而是连同当时的纪元放入等待队列，等到纪元前进两次(所有可能持有句柄的读者都已离开)再交给缓存复用
+        从未交出过句柄的结点不经过这里，没有使用 getHandle 时没有任何额外开销
+        除 pin() 外，所有接口都由持有缓存写锁的线程调用
+    */
+    template <typename NODE>
+    class myPinnedNodes
+    {
+    public:
+        // 进入纪元临界区，返回的 Guard 交给句柄持有；需要在查找结点之前调用
+        myEpochReclaimer::Guard pin()
+        {
+            return reclaimer_.enter();
+        }
+
+        // 已经从缓存中摘下、可能仍被句柄引用的结点
+        void retire(NODE *node)
+        {
+            retired_.push_back({node, reclaimer_.retireEpoch()});
+        }
+
+        // 已经摘下、可能仍被读者访问的其他对象(如被替换的索引表)，纪元前进两次后 delete
+        template <typename T>
+        void retireObject(T *object)
+        {
+            reclaimer_.retire(object);
+        }
+
+        // 把已经没有句柄引用的结点交给 recycle(按摘下的先后顺序)
+        template <typename FN>
+        void reclaim(FN &&recycle)
+        {
+            while (!retired_.empty() && reclaimer_.reclaimable(retired_.front().second))
+            {
+                NODE *node = retired_.front().first;
+                retired_.pop_front();
+                recycle(node);
+            }
+        }
+
+        // 等待回收的结点数量
+        size_t size() const
+        {
+            return retired_.size();
+        }
+
+        bool empty() const
+        {
+            return retired_.empty();
+        }
+
+    private:
+        myEpochReclaimer reclaimer_;                        // 纪元
+        std::deque<std::pair<NODE *, uint64_t>> retired_;   // 等待回收的结点和摘下时的纪元
+    };
+} // namespace myCacheSystem
+
+#endif // MYVALUEHANDLE_H
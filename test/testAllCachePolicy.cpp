@@ -2,12 +2,23 @@
 #include "myLru.h"
 #include "myLfu.h"
 #include "myArcCache.h"
+#include "myTinyLfu.h"
+#include "mySlru.h"
+#include "myS3Fifo.h"
+#include "my2Q.h"
+#include "myLirs.h"
+#include "myCuckooCache.h"
+#include "myTask.h"
 #include <string>
 #include <vector>
 #include <random>
 #include <chrono>
 #include <iomanip>
 #include <algorithm>
+#include <array>
+#include <thread>
+#include <atomic>
+#include <functional>
 
 // 打印结果
 void printResult(const std::string &message, const std::vector<std::string> &names, int capacity, const std::vector<int> &hits, const std::vector<int> &get_operations)
@@ -45,12 +56,19 @@ void testHotData()
     myCacheSystem::myArcCache<int, std::string> arc(CAPACITY);
     myCacheSystem::myKLruCache<int, std::string> klru(CAPACITY, HOT_KEY + COLD_KEY, 2);
     myCacheSystem::myLfuCache<int, std::string> lfuAging(CAPACITY, 20000);
+    myCacheSystem::myLruCache<int, std::string> lruClock(CAPACITY, myCacheSystem::myLruMode::Clock);
+    myCacheSystem::myTinyLfuCache<int, std::string> tinyLfu(CAPACITY);
+    myCacheSystem::myKLruCache<int, std::string> klruRetain(CAPACITY, HOT_KEY + COLD_KEY, 2, {}, true);
+    myCacheSystem::mySlruCache<int, std::string> slru(CAPACITY);
+    myCacheSystem::myS3FifoCache<int, std::string> s3Fifo(CAPACITY);
+    myCacheSystem::my2QCache<int, std::string> twoQ(CAPACITY);
+    myCacheSystem::myLirsCache<int, std::string> lirs(CAPACITY);
 
     // 3. 定义保存结果的数据结构
-    std::array<myCacheSystem::myCachePolicy<int, std::string> *, 5> cache{&lru, &lfu, &arc, &klru, &lfuAging}; // 缓冲池
-    std::vector<int> hits(5, 0);                                                                               // 保存缓存命中数
-    std::vector<int> get_operations(5, 0);                                                                     // 三种策略测试分别get访问缓存总次数
-    std::vector<std::string> names = {"LRU", "LFU", "ARC", "LRU-K", "LFU-Aging"};
+    std::vector<myCacheSystem::myCachePolicy<int, std::string> *> cache{&lru, &lfu, &arc, &klru, &lfuAging, &lruClock, &tinyLfu, &klruRetain, &slru, &s3Fifo, &twoQ, &lirs}; // 缓冲池
+    std::vector<int> hits(cache.size(), 0);                                                                           // 保存缓存命中数
+    std::vector<int> get_operations(cache.size(), 0);                                                                 // 各策略测试分别get访问缓存总次数
+    std::vector<std::string> names = {"LRU", "LFU", "ARC", "LRU-K", "LFU-Aging", "LRU-CLOCK", "W-TinyLFU", "LRU-K-Retain", "SLRU", "S3-FIFO", "2Q", "LIRS"};
     std::random_device rd; // 生成随机数
     std::mt19937 gen(rd());
 
@@ -115,12 +133,19 @@ void testLoopPattern()
     myCacheSystem::myArcCache<int, std::string> arc(CAPACITY);
     myCacheSystem::myKLruCache<int, std::string> klru(CAPACITY, LOOP_SIZE * 2, 2);
     myCacheSystem::myLfuCache<int, std::string> lfuAging(CAPACITY, 3000);
-    std::array<myCacheSystem::myCachePolicy<int, std::string> *, 5> caches = {&lru, &lfu, &arc, &klru, &lfuAging};
+    myCacheSystem::myLruCache<int, std::string> lruClock(CAPACITY, myCacheSystem::myLruMode::Clock);
+    myCacheSystem::myTinyLfuCache<int, std::string> tinyLfu(CAPACITY);
+    myCacheSystem::mySlruCache<int, std::string> slru(CAPACITY);
+    myCacheSystem::myS3FifoCache<int, std::string> s3Fifo(CAPACITY);
+    myCacheSystem::my2QCache<int, std::string> twoQ(CAPACITY);
+    myCacheSystem::myArcCache<int, std::string> arcWideGhost(CAPACITY, 2, {}, CAPACITY * 4);
+    myCacheSystem::myLirsCache<int, std::string> lirs(CAPACITY);
+    std::vector<myCacheSystem::myCachePolicy<int, std::string> *> caches = {&lru, &lfu, &arc, &lirs, &klru, &lfuAging, &lruClock, &tinyLfu, &arcWideGhost, &slru, &s3Fifo, &twoQ};
 
     // 设置结果数据
-    std::vector<int> hits(5, 0); // 保存命中数
-    std::vector<std::string> names = {"LRU", "LFU", "ARC", "LRU-K", "LFU-Aging"};
-    std::vector<int> get_operations(5, 0); // 保存访问缓存操作数
+    std::vector<int> hits(caches.size(), 0); // 保存命中数
+    std::vector<std::string> names = {"LRU", "LFU", "ARC", "LIRS", "LRU-K", "LFU-Aging", "LRU-CLOCK", "W-TinyLFU", "ARC-WideGhost", "SLRU", "S3-FIFO", "2Q"};
+    std::vector<int> get_operations(caches.size(), 0); // 保存访问缓存操作数
 
     // 随机数分布器
     std::random_device rd;
@@ -195,12 +220,19 @@ void testWorkLoadShift()
     myCacheSystem::myArcCache<int, std::string> arc(CAPACITY);
     myCacheSystem::myKLruCache<int, std::string> klru(CAPACITY, 500, 2);
     myCacheSystem::myLfuCache<int, std::string> lfuAging(CAPACITY, 10000);
-    std::array<myCacheSystem::myCachePolicy<int, std::string> *, 5> caches = {&lru, &lfu, &arc, &klru, &lfuAging};
+    myCacheSystem::myLruCache<int, std::string> lruClock(CAPACITY, myCacheSystem::myLruMode::Clock);
+    myCacheSystem::myLfuCache<int, std::string> lfuHalve(CAPACITY, 20, false, {}, myCacheSystem::myLfuDecay::Halve);
+    myCacheSystem::myTinyLfuCache<int, std::string> tinyLfu(CAPACITY);
+    myCacheSystem::mySlruCache<int, std::string> slru(CAPACITY);
+    myCacheSystem::myS3FifoCache<int, std::string> s3Fifo(CAPACITY);
+    myCacheSystem::my2QCache<int, std::string> twoQ(CAPACITY);
+    myCacheSystem::myLirsCache<int, std::string> lirs(CAPACITY);
+    std::vector<myCacheSystem::myCachePolicy<int, std::string> *> caches = {&lru, &lfu, &arc, &klru, &lfuAging, &lruClock, &lfuHalve, &tinyLfu, &slru, &s3Fifo, &twoQ, &lirs};
 
     // 设置结果数据
-    std::vector<int> hits(5, 0); // 保存命中数
-    std::vector<std::string> names = {"LRU", "LFU", "ARC", "LRU-K", "LFU-Aging"};
-    std::vector<int> get_operations(5, 0); // 保存访问缓存操作数
+    std::vector<int> hits(caches.size(), 0); // 保存命中数
+    std::vector<std::string> names = {"LRU", "LFU", "ARC", "LRU-K", "LFU-Aging", "LRU-CLOCK", "LFU-Halve", "W-TinyLFU", "SLRU", "S3-FIFO", "2Q", "LIRS"};
+    std::vector<int> get_operations(caches.size(), 0); // 保存访问缓存操作数
 
     // 随机数分布器
     std::random_device rd;
@@ -304,11 +336,659 @@ void testWorkLoadShift()
     printResult("工作负载剧烈变化测试", names, CAPACITY, hits, get_operations);
 }
 
+// 测试多线程读多写少场景下的吞吐量
+void testConcurrentRead()
+{
+    std::cout << "\n=== 测试场景4：多线程读多写少吞吐测试 ===" << std::endl;
+
+    const int CAPACITY = 1000;
+    const int KEY_RANGE = 1200;
+    const int OPERATIONS = 200000; // 每个线程的操作次数
+    const int THREADS = std::max(2u, std::thread::hardware_concurrency());
+
+    myCacheSystem::myLruCache<int, std::string> lru(CAPACITY);
+    myCacheSystem::myLruCache<int, std::string> lruClock(CAPACITY, myCacheSystem::myLruMode::Clock);
+    myCacheSystem::myLruCache<int, std::string> lruBuffered(CAPACITY, myCacheSystem::myLruMode::Buffered);
+    myCacheSystem::myLfuCache<int, std::string> lfu(CAPACITY);
+    myCacheSystem::myLfuCache<int, std::string> lfuBuffered(CAPACITY, 1000000, true);
+    myCacheSystem::myKHashLruCache<int, std::string> hashKLru(CAPACITY, THREADS, KEY_RANGE, 2);
+    myCacheSystem::myHashLfuCache<int, std::string> hashLfu(CAPACITY, THREADS, 1000000);
+    myCacheSystem::myArcCache<int, std::string> arc(CAPACITY);
+    myCacheSystem::myHashArcCache<int, std::string> hashArc(CAPACITY, THREADS);
+    myCacheSystem::myS3FifoCache<int, std::string> s3Fifo(CAPACITY);
+    myCacheSystem::myHash2QCache<int, std::string> hash2Q(CAPACITY, THREADS);
+    myCacheSystem::myCuckooCache<int, std::string> cuckoo(CAPACITY);
+    std::vector<myCacheSystem::myCachePolicy<int, std::string> *> caches = {&lru, &lruClock, &lruBuffered, &lfu, &lfuBuffered, &hashKLru, &hashLfu, &arc, &hashArc, &s3Fifo, &hash2Q, &cuckoo};
+    std::vector<std::string> names = {"LRU", "LRU-CLOCK", "LRU-Buffered", "LFU", "LFU-Buffered", "Hash-LRU-K", "Hash-LFU", "ARC", "Hash-ARC", "S3-FIFO", "Hash-2Q", "Cuckoo"};
+
+    std::cout << "线程数: " << THREADS << std::endl;
+    for (size_t i = 0; i < caches.size(); ++i)
+    {
+        // 预热两轮，LRU-K需要第二次访问才会进入主缓存
+        for (int round = 0; round < 2; ++round)
+        {
+            for (int key = 0; key < CAPACITY; ++key)
+            {
+                caches[i]->put(key, "value" + std::to_string(key));
+            }
+        }
+
+        std::atomic<long> hits{0};
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> workers;
+        for (int t = 0; t < THREADS; ++t)
+        {
+            workers.emplace_back([&, t]()
+                                 {
+                std::mt19937 gen(t);
+                std::string result;
+                long localHits = 0;
+                for (int op = 0; op < OPERATIONS; ++op)
+                {
+                    int key = gen() % KEY_RANGE;
+                    // 95%读，5%写
+                    if (gen() % 100 < 5)
+                    {
+                        caches[i]->put(key, "value" + std::to_string(key));
+                    }
+                    else if (caches[i]->get(key, result))
+                    {
+                        ++localHits;
+                    }
+                }
+                hits += localHits; });
+        }
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << names[i] << "- 吞吐：" << std::fixed << std::setprecision(2)
+                  << (THREADS * OPERATIONS / seconds / 1e6) << " Mops/s"
+                  << " 命中数：" << hits.load() << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+// 测试分片缓存的批量接口：逐个查询与按分片分组后批量查询对比
+void testBatchLookup()
+{
+    std::cout << "\n=== 测试场景5：分片缓存批量查询测试 ===" << std::endl;
+
+    const int CAPACITY = 4096;
+    const int KEY_RANGE = 5000;
+    const int BATCH = 100;     // 每批key数量
+    const int BATCHES = 20000; // 每个线程的批次数
+    const int THREADS = std::max(2u, std::thread::hardware_concurrency());
+
+    myCacheSystem::myHashLfuCache<int, std::string> hashLfu(CAPACITY, THREADS, 1000000);
+    myCacheSystem::myKHashLruCache<int, std::string> hashKLru(CAPACITY, THREADS, KEY_RANGE, 2);
+    myCacheSystem::myHashArcCache<int, std::string> hashArc(CAPACITY, THREADS);
+    myCacheSystem::myHash2QCache<int, std::string> hash2Q(CAPACITY, THREADS);
+    myCacheSystem::myCuckooCache<int, std::string> cuckoo(CAPACITY);
+    std::vector<myCacheSystem::myCachePolicy<int, std::string> *> caches = {&hashLfu, &hashKLru, &hashArc, &hash2Q, &cuckoo};
+    std::vector<std::string> names = {"Hash-LFU", "Hash-LRU-K", "Hash-ARC", "Hash-2Q", "Cuckoo"};
+
+    for (size_t i = 0; i < caches.size(); ++i)
+    {
+        for (int round = 0; round < 2; ++round)
+        {
+            for (int key = 0; key < CAPACITY; ++key)
+            {
+                caches[i]->put(key, "value" + std::to_string(key));
+            }
+        }
+
+        for (bool batched : {false, true})
+        {
+            auto start = std::chrono::steady_clock::now();
+            std::vector<std::thread> workers;
+            for (int t = 0; t < THREADS; ++t)
+            {
+                workers.emplace_back([&, t]()
+                                     {
+                    std::mt19937 gen(t);
+                    std::vector<int> keys(BATCH);
+                    std::vector<std::string> values(BATCH);
+                    std::vector<bool> hits;
+                    for (int b = 0; b < BATCHES; ++b)
+                    {
+                        for (auto &key : keys)
+                        {
+                            key = gen() % KEY_RANGE;
+                        }
+                        if (batched)
+                        {
+                            caches[i]->getMany(keys, values, hits);
+                        }
+                        else
+                        {
+                            for (int k = 0; k < BATCH; ++k)
+                            {
+                                caches[i]->get(keys[k], values[k]);
+                            }
+                        }
+                    } });
+            }
+            for (auto &worker : workers)
+            {
+                worker.join();
+            }
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            std::cout << names[i] << (batched ? " getMany" : " get") << "- 吞吐：" << std::fixed << std::setprecision(2)
+                      << (1.0 * THREADS * BATCHES * BATCH / seconds / 1e6) << " Mkeys/s" << std::endl;
+        }
+    }
+    std::cout << std::endl;
+}
+
+// 按字节权重限制容量：value 大小差别很大，统计命中率以及总权重是否始终不超过预算
+void testWeightedCapacity()
+{
+    std::cout << "=== 测试场景6：字节权重容量测试 ===" << std::endl;
+
+    const size_t BUDGET = 256 * 1024; // 字节预算
+    const int KEY_RANGE = 2000;
+    const int OPERATIONS = 200000;
+
+    // value 长度 50B ~ 8KB，小对象占多数
+    auto valueSize = [](int key)
+    { return key % 10 == 0 ? 8192 : 50 + key % 500; };
+    myCacheSystem::myWeigher<int, std::string> weigher = [](const int &, const std::string &value)
+    { return sizeof(int) + value.size(); };
+
+    myCacheSystem::myLruCache<int, std::string> lru(BUDGET, myCacheSystem::myLruMode::Strict, weigher);
+    myCacheSystem::myLfuCache<int, std::string> lfu(BUDGET, 1000000, false, weigher);
+    myCacheSystem::myArcCache<int, std::string> arc(BUDGET, 2, weigher);
+    myCacheSystem::myHashLfuCache<int, std::string> hashLfu(BUDGET, 4, 1000000, weigher);
+    myCacheSystem::mySlruCache<int, std::string> slru(BUDGET, 0.8, weigher);
+
+    std::vector<myCacheSystem::myCachePolicy<int, std::string> *> caches = {&lru, &lfu, &arc, &hashLfu, &slru};
+    std::vector<std::string> names = {"LRU", "LFU", "ARC", "Hash-LFU", "SLRU"};
+    std::vector<std::function<size_t()>> weights = {[&]()
+                                                    { return lru.weight(); }, [&]()
+                                                    { return lfu.weight(); }, [&]()
+                                                    { return arc.weight(); }, [&]()
+                                                    { return hashLfu.weight(); }, [&]()
+                                                    { return slru.weight(); }};
+
+    for (size_t i = 0; i < caches.size(); ++i)
+    {
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<int> dist(0, KEY_RANGE - 1);
+        int hits = 0;
+        size_t maxWeight = 0;
+        for (int op = 0; op < OPERATIONS; ++op)
+        {
+            // 平方分布制造热点
+            int key = dist(gen) * dist(gen) / KEY_RANGE;
+            std::string value;
+            if (caches[i]->get(key, value))
+            {
+                ++hits;
+            }
+            else
+            {
+                caches[i]->put(key, std::string(valueSize(key), 'x'));
+            }
+            maxWeight = std::max(maxWeight, weights[i]());
+        }
+        std::cout << names[i] << "- 命中率：" << std::fixed << std::setprecision(2) << 100.0 * hits / OPERATIONS << "%"
+                  << " 最大权重：" << maxWeight << "/" << BUDGET << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+// 过期时间：一半的key带ttl写入，过期后读取应当未命中，且过期结点在后续操作中被逐步回收
+void testExpiration()
+{
+    std::cout << "=== 测试场景7：过期时间测试 ===" << std::endl;
+
+    const int CAPACITY = 1000;
+    const auto TTL = std::chrono::milliseconds(50);
+
+    myCacheSystem::myLruCache<int, std::string> lru(CAPACITY);
+    myCacheSystem::myLfuCache<int, std::string> lfu(CAPACITY);
+    myCacheSystem::myArcCache<int, std::string> arc(CAPACITY);
+    myCacheSystem::myKHashLruCache<int, std::string> hashKLru(CAPACITY, 4, CAPACITY, 1);
+    std::vector<myCacheSystem::myCachePolicy<int, std::string> *> caches = {&lru, &lfu, &arc, &hashKLru};
+    std::vector<std::string> names = {"LRU", "LFU", "ARC", "Hash-LRU-K"};
+
+    for (auto cache : caches)
+    {
+        for (int key = 0; key < CAPACITY; ++key)
+        {
+            if (key % 2 == 0)
+            {
+                cache->put(key, "value" + std::to_string(key), TTL);
+            }
+            else
+            {
+                cache->put(key, "value" + std::to_string(key));
+            }
+        }
+    }
+
+    auto countHits = [&](myCacheSystem::myCachePolicy<int, std::string> *cache)
+    {
+        int hits = 0;
+        std::string value;
+        for (int key = 0; key < CAPACITY; ++key)
+        {
+            hits += cache->get(key, value) ? 1 : 0;
+        }
+        return hits;
+    };
+
+    std::vector<int> before;
+    for (auto cache : caches)
+    {
+        before.push_back(countHits(cache));
+    }
+    std::this_thread::sleep_for(TTL * 2);
+    for (size_t i = 0; i < caches.size(); ++i)
+    {
+        std::cout << names[i] << "- 过期前命中：" << before[i] << "/" << CAPACITY
+                  << " 过期后命中：" << countHits(caches[i]) << "/" << CAPACITY << std::endl;
+    }
+    std::cout << "LRU 回收后缓存项数量：" << lru.weight() << std::endl;
+    std::cout << std::endl;
+}
+
+// 大value读取：get 每次拷贝整个value，getHandle 返回指向缓存中value的句柄，期间有少量覆盖写入
+void testValueHandle()
+{
+    std::cout << "=== 测试场景8：大value零拷贝读取测试 ===" << std::endl;
+
+    const int CAPACITY = 256;
+    const int KEY_RANGE = 256;
+    const size_t VALUE_SIZE = 64 * 1024; // 64KB
+    const int OPERATIONS = 20000;        // 每个线程的操作次数
+    const int THREADS = std::max(2u, std::thread::hardware_concurrency());
+
+    myCacheSystem::myLruCache<int, std::string> lru(CAPACITY);
+    myCacheSystem::myLfuCache<int, std::string> lfu(CAPACITY);
+    myCacheSystem::myArcCache<int, std::string> arc(CAPACITY);
+    myCacheSystem::myCuckooCache<int, std::string> cuckoo(CAPACITY);
+    std::vector<myCacheSystem::myCachePolicy<int, std::string> *> caches = {&lru, &lfu, &arc, &cuckoo};
+    std::vector<std::string> names = {"LRU", "LFU", "ARC", "Cuckoo"};
+    std::vector<std::function<size_t(int)>> readHandle = {[&](int key)
+                                                          { auto handle = lru.getHandle(key); return handle ? handle->size() : 0; }, [&](int key)
+                                                          { auto handle = lfu.getHandle(key); return handle ? handle->size() : 0; }, [&](int key)
+                                                          { auto handle = arc.getHandle(key); return handle ? handle->size() : 0; }, [&](int key)
+                                                          { auto handle = cuckoo.getHandle(key); return handle ? handle->size() : 0; }};
+
+    for (size_t i = 0; i < caches.size(); ++i)
+    {
+        for (int key = 0; key < KEY_RANGE; ++key)
+        {
+            caches[i]->put(key, std::string(VALUE_SIZE, 'a' + key % 26));
+        }
+
+        for (bool zeroCopy : {false, true})
+        {
+            std::atomic<size_t> bytes{0};
+            auto start = std::chrono::steady_clock::now();
+            std::vector<std::thread> workers;
+            for (int t = 0; t < THREADS; ++t)
+            {
+                workers.emplace_back([&, t]()
+                                     {
+                    std::mt19937 gen(t);
+                    std::string value;
+                    size_t localBytes = 0;
+                    for (int op = 0; op < OPERATIONS; ++op)
+                    {
+                        int key = gen() % KEY_RANGE;
+                        // 1%覆盖写入，其余读取
+                        if (gen() % 100 == 0)
+                        {
+                            caches[i]->put(key, std::string(VALUE_SIZE, 'a' + key % 26));
+                        }
+                        else if (zeroCopy)
+                        {
+                            localBytes += readHandle[i](key);
+                        }
+                        else if (caches[i]->get(key, value))
+                        {
+                            localBytes += value.size();
+                        }
+                    }
+                    bytes += localBytes; });
+            }
+            for (auto &worker : workers)
+            {
+                worker.join();
+            }
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            std::cout << names[i] << (zeroCopy ? " getHandle" : " get") << "- 吞吐：" << std::fixed << std::setprecision(2)
+                      << (THREADS * OPERATIONS / seconds / 1e6) << " Mops/s"
+                      << " 读取：" << bytes.load() / (1024 * 1024) << "MB" << std::endl;
+        }
+    }
+    std::cout << std::endl;
+}
+
+// 热点key过期后大量线程同时未命中：get 未命中后各自回源，getOrLoad 同一个key只回源一次
+void testSingleFlight()
+{
+    std::cout << "=== 测试场景9：热点key并发回源测试 ===" << std::endl;
+
+    const int CAPACITY = 1000;
+    const int THREADS = 32;
+    const int ROUNDS = 5;
+    const auto TTL = std::chrono::milliseconds(20);
+    const auto LOAD_LATENCY = std::chrono::milliseconds(5);
+
+    myCacheSystem::myLruCache<int, std::string> lru(CAPACITY);
+    myCacheSystem::myHashLfuCache<int, std::string> hashLfu(CAPACITY, 4);
+    myCacheSystem::myHashArcCache<int, std::string> hashArc(CAPACITY, 4);
+    myCacheSystem::myCuckooCache<int, std::string> cuckoo(CAPACITY);
+    std::vector<myCacheSystem::myCachePolicy<int, std::string> *> caches = {&lru, &hashLfu, &hashArc, &cuckoo};
+    std::vector<std::string> names = {"LRU", "Hash-LFU", "Hash-ARC", "Cuckoo"};
+
+    for (size_t i = 0; i < caches.size(); ++i)
+    {
+        for (bool coalesce : {false, true})
+        {
+            std::atomic<int> loads{0};
+            auto loader = [&](const int &key)
+            {
+                ++loads;
+                std::this_thread::sleep_for(LOAD_LATENCY);
+                return "value" + std::to_string(key);
+            };
+            for (int round = 0; round < ROUNDS; ++round)
+            {
+                // 每轮等待热点key过期后，所有线程同时读取
+                std::this_thread::sleep_for(TTL * 2);
+                std::vector<std::thread> workers;
+                for (int t = 0; t < THREADS; ++t)
+                {
+                    workers.emplace_back([&]()
+                                         {
+                        if (coalesce)
+                        {
+                            caches[i]->getOrLoad(0, loader, TTL);
+                            return;
+                        }
+                        std::string value;
+                        if (!caches[i]->get(0, value))
+                        {
+                            caches[i]->put(0, loader(0), TTL);
+                        } });
+                }
+                for (auto &worker : workers)
+                {
+                    worker.join();
+                }
+            }
+            std::cout << names[i] << (coalesce ? " getOrLoad" : " get+put") << "- 回源次数：" << loads.load()
+                      << "(" << ROUNDS << "轮 x " << THREADS << "线程)" << std::endl;
+        }
+    }
+    std::cout << std::endl;
+}
+
+// 协程请求：先读热点key(未命中时合并回源)，再做若干次读写，返回命中次数
+myCacheSystem::myTask<int> asyncRequest(myCacheSystem::myCachePolicy<int, std::string> &cache, int id, int hotKeys, int operations,
+                                        std::function<std::string(const int &)> loader, myCacheSystem::myExecutor &executor)
+{
+    co_await cache.getOrLoadAsync(id % hotKeys, loader, executor);
+    int hits = 0;
+    for (int op = 0; op < operations; ++op)
+    {
+        int key = hotKeys + (id + op) % 256;
+        if (op % 4 == 0)
+        {
+            co_await cache.putAsync(key, "value" + std::to_string(key), executor);
+        }
+        else if (co_await cache.getAsync(key, executor))
+        {
+            ++hits;
+        }
+    }
+    co_return hits;
+}
+
+void testAsyncApi()
+{
+    std::cout << "=== 测试场景10：协程接口测试 ===" << std::endl;
+
+    const int CAPACITY = 1000;
+    const int REQUESTS = 1000;
+    const int HOT_KEYS = 10;
+    const int OPERATIONS = 100;
+    const auto LOAD_LATENCY = std::chrono::milliseconds(5);
+
+    myCacheSystem::myExecutor executor(2);
+    myCacheSystem::myLruCache<int, std::string> lru(CAPACITY);
+    myCacheSystem::myHashLfuCache<int, std::string> hashLfu(CAPACITY, 4);
+    myCacheSystem::myHashArcCache<int, std::string> hashArc(CAPACITY, 4);
+    myCacheSystem::myCuckooCache<int, std::string> cuckoo(CAPACITY);
+    std::vector<myCacheSystem::myCachePolicy<int, std::string> *> caches = {&lru, &hashLfu, &hashArc, &cuckoo};
+    std::vector<std::string> names = {"LRU", "Hash-LFU", "Hash-ARC", "Cuckoo"};
+
+    for (size_t i = 0; i < caches.size(); ++i)
+    {
+        std::atomic<int> loads{0};
+        auto loader = [&](const int &key)
+        {
+            ++loads;
+            std::this_thread::sleep_for(LOAD_LATENCY);
+            return "value" + std::to_string(key);
+        };
+
+        // 所有请求由当前线程(相当于事件循环)发起，挂起的请求在 executor 的工作线程上恢复
+        auto start = std::chrono::steady_clock::now();
+        std::vector<myCacheSystem::myTask<int>> requests;
+        for (int id = 0; id < REQUESTS; ++id)
+        {
+            requests.push_back(asyncRequest(*caches[i], id, HOT_KEYS, OPERATIONS, loader, executor));
+        }
+        std::vector<int> hits = myCacheSystem::mySyncWaitAll(std::move(requests));
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+        int totalHits = 0;
+        for (int h : hits)
+        {
+            totalHits += h;
+        }
+        std::cout << names[i] << " - " << REQUESTS << "个并发请求，线程数：1+" << executor.threads()
+                  << "，回源次数：" << loads.load() << "，命中次数：" << totalHits
+                  << "，耗时：" << elapsed.count() << "ms" << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+// 热点key预热后持续读取，统计读线程同步回源次数和最大读取延迟；refresh 为 true 时开启写入后刷新
+// 缓存在计数器之后构造，先于计数器析构，析构时等待的后台刷新不会访问已经销毁的计数器
+template <typename CACHE, typename... ARGS>
+void runRefreshAhead(const std::string &name, bool refresh, ARGS... args)
+{
+    const int THREADS = 8;
+    const int HOT_KEYS = 8;
+    const auto TTL = std::chrono::milliseconds(100);
+    const auto REFRESH_AFTER = std::chrono::milliseconds(50);
+    const auto LOAD_LATENCY = std::chrono::milliseconds(5);
+    const auto DURATION = std::chrono::milliseconds(600);
+
+    std::atomic<int> syncLoads{0};
+    std::atomic<int> refreshLoads{0};
+    CACHE cache(args...);
+    if (refresh)
+    {
+        cache.enableRefresh(REFRESH_AFTER, [&](const int &key)
+                            {
+            ++refreshLoads;
+            std::this_thread::sleep_for(LOAD_LATENCY);
+            return "value" + std::to_string(key); });
+    }
+    auto loader = [&](const int &key)
+    {
+        ++syncLoads;
+        std::this_thread::sleep_for(LOAD_LATENCY);
+        return "value" + std::to_string(key);
+    };
+
+    // 预热：先加载所有热点key，之后的同步回源都发生在过期时
+    for (int key = 0; key < HOT_KEYS; ++key)
+    {
+        cache.getOrLoad(key, loader, TTL);
+    }
+    syncLoads = 0;
+
+    std::atomic<long long> maxLatency{0};
+    auto end = std::chrono::steady_clock::now() + DURATION;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < THREADS; ++t)
+    {
+        workers.emplace_back([&, t]()
+                             {
+            long long localMax = 0;
+            for (int i = t; std::chrono::steady_clock::now() < end; ++i)
+            {
+                auto start = std::chrono::steady_clock::now();
+                cache.getOrLoad(i % HOT_KEYS, loader, TTL);
+                localMax = std::max<long long>(localMax, std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+            long long seen = maxLatency.load();
+            while (localMax > seen && !maxLatency.compare_exchange_weak(seen, localMax))
+            {
+            } });
+    }
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+    std::cout << name << (refresh ? " TTL+刷新" : " 仅TTL") << " - 同步回源次数：" << syncLoads.load()
+              << "，后台刷新次数：" << refreshLoads.load()
+              << "，最大读取延迟：" << std::fixed << std::setprecision(2) << maxLatency.load() / 1000.0 << "ms" << std::endl;
+}
+
+void testRefreshAhead()
+{
+    std::cout << "=== 测试场景11：热点key写入后刷新测试 ===" << std::endl;
+
+    const int CAPACITY = 1000;
+
+    for (bool refresh : {false, true})
+    {
+        runRefreshAhead<myCacheSystem::myLruCache<int, std::string>>("LRU", refresh, CAPACITY);
+    }
+    for (bool refresh : {false, true})
+    {
+        runRefreshAhead<myCacheSystem::myHashLfuCache<int, std::string>>("Hash-LFU", refresh, CAPACITY, 4);
+    }
+    for (bool refresh : {false, true})
+    {
+        runRefreshAhead<myCacheSystem::myHashArcCache<int, std::string>>("Hash-ARC", refresh, CAPACITY, 4);
+    }
+    std::cout << std::endl;
+}
+
+// 记录存活的 value 字节数，用于检查淘汰和清空之后 value 是否真的被释放
+struct CountedValue
+{
+    static inline size_t liveBytes = 0;
+
+    CountedValue() : size(0) {}
+    explicit CountedValue(size_t n) : size(n) { liveBytes += size; }
+    CountedValue(const CountedValue &other) : size(other.size) { liveBytes += size; }
+    CountedValue(CountedValue &&other) noexcept : size(other.size) { other.size = 0; }
+    CountedValue &operator=(const CountedValue &other)
+    {
+        liveBytes = liveBytes - size + other.size;
+        size = other.size;
+        return *this;
+    }
+    CountedValue &operator=(CountedValue &&other) noexcept
+    {
+        liveBytes -= size;
+        size = other.size;
+        other.size = 0;
+        return *this;
+    }
+    ~CountedValue() { liveBytes -= size; }
+
+    size_t size;
+};
+
+// 写满小对象后写入一个大对象挤出大量结点，存活的 value 字节数不应超过缓存记录的权重，清空后应当归零
+template <typename CACHE>
+bool runValueRelease(const std::string &name, CACHE &cache, size_t budget)
+{
+    const size_t SMALL_SIZE = 100;
+    const int SMALL_NUMBER = 10000;
+
+    for (int key = 0; key < SMALL_NUMBER; ++key)
+    {
+        cache.put(key, CountedValue(SMALL_SIZE));
+    }
+    cache.put(SMALL_NUMBER, CountedValue(budget / 2));
+    size_t afterEvict = CountedValue::liveBytes;
+    size_t weight = cache.weight();
+    cache.clear();
+    size_t afterClear = CountedValue::liveBytes;
+
+    bool passed = afterEvict <= weight && afterClear == 0;
+    std::cout << name << "- 淘汰后存活value：" << afterEvict << "B 权重：" << weight << "/" << budget
+              << " 清空后存活value：" << afterClear << "B " << (passed ? "通过" : "未通过") << std::endl;
+    return passed;
+}
+
+bool testValueRelease()
+{
+    std::cout << "=== 测试场景12：淘汰与清空后value释放测试 ===" << std::endl;
+
+    const size_t BUDGET = 256 * 1024; // 字节预算
+    myCacheSystem::myWeigher<int, CountedValue> weigher = [](const int &, const CountedValue &value)
+    { return sizeof(int) + value.size; };
+
+    bool passed = true;
+    {
+        myCacheSystem::myLruCache<int, CountedValue> lru(BUDGET, myCacheSystem::myLruMode::Strict, weigher);
+        passed = runValueRelease("LRU", lru, BUDGET) && passed;
+    }
+    {
+        myCacheSystem::myLfuCache<int, CountedValue> lfu(BUDGET, 1000000, false, weigher);
+        passed = runValueRelease("LFU", lfu, BUDGET) && passed;
+    }
+    {
+        myCacheSystem::myArcCache<int, CountedValue> arc(BUDGET, 2, weigher);
+        passed = runValueRelease("ARC", arc, BUDGET) && passed;
+    }
+    {
+        myCacheSystem::myHashLfuCache<int, CountedValue> hashLfu(BUDGET, 4, 1000000, weigher);
+        passed = runValueRelease("Hash-LFU", hashLfu, BUDGET) && passed;
+    }
+    {
+        myCacheSystem::mySlruCache<int, CountedValue> slru(BUDGET, 0.8, weigher);
+        passed = runValueRelease("SLRU", slru, BUDGET) && passed;
+    }
+    {
+        myCacheSystem::my2QCache<int, CountedValue> twoQueue(BUDGET, 0.25, 0.5, weigher);
+        passed = runValueRelease("2Q", twoQueue, BUDGET) && passed;
+    }
+    std::cout << std::endl;
+    return passed;
+}
+
 int main()
 {
     testHotData();
     testLoopPattern();
     testWorkLoadShift();
-
-    return 0;
+    testConcurrentRead();
+    testBatchLookup();
+    testWeightedCapacity();
+    testExpiration();
+    testValueHandle();
+    testSingleFlight();
+    testAsyncApi();
+    testRefreshAhead();
+    bool released = testValueRelease();
+
+    return released ? 0 : 1;
 }
\ No newline at end of file